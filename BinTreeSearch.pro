@@ -28,12 +28,17 @@ SOURCES += \
         main.cpp \
         mainwindow.cpp \
     graphview.cpp \
-    binarytree.cpp
+    stepscheduler.cpp \
+    animationdriver.cpp
 
 HEADERS += \
         mainwindow.h \
     graphview.h \
-    binarytree.h
+    stepscheduler.h \
+    animationdriver.h
+
+# 不依赖Qt的二叉树核心
+include(core/core.pri)
 
 FORMS += \
         mainwindow.ui
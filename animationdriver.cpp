@@ -0,0 +1,126 @@
+#include "animationdriver.h"
+#include "graphview.h"
+
+/**
+ * @brief animationDriver::animationDriver
+ * @param _duration 每个动画的毫秒数
+ * @param parent 对象树的父亲指针
+ */
+animationDriver::animationDriver(int _duration, QObject* parent):
+    QObject(parent),
+    duration(_duration)
+{
+    timer.setInterval(16);      // 约60帧每秒
+    connect(&timer, &QTimer::timeout, this, &animationDriver::handleTick);
+    clock.start();
+}
+
+/**
+ * @brief animationDriver::start 开始结点的弹出动画，结点已有动画时复用其槽位
+ * @param vex 结点
+ * @param withNameTag 是否同时淡入名称
+ */
+void animationDriver::start(graphicsVexItem* vex, bool withNameTag)
+{
+    if(!enabled){
+        vex->applyPopOut(1, withNameTag);
+        return;
+    }
+
+    int slot = vex->animationSlot;
+    if(slot < 0){
+        if(!freeSlots.empty()){
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        else{
+            slot = animations.size();
+            animations.push_back(animation());
+        }
+        vex->animationSlot = slot;
+        ++activeNum;
+    }
+    else
+        withNameTag = withNameTag || animations[slot].withNameTag;  // 名称尚未淡入完成时继续淡入
+
+    animation& a = animations[slot];
+    a.vex = vex;
+    a.startTime = clock.elapsed();
+    a.withNameTag = withNameTag;
+    vex->applyPopOut(0, withNameTag);
+
+    if(!timer.isActive())
+        timer.start();
+}
+
+/**
+ * @brief animationDriver::stop 把结点的动画直接跳到结束状态并归还槽位
+ * @param vex 结点
+ */
+void animationDriver::stop(graphicsVexItem* vex)
+{
+    int slot = vex->animationSlot;
+    if(slot < 0)
+        return;
+    vex->applyPopOut(1, animations[slot].withNameTag);
+    release(slot);
+}
+
+void animationDriver::stopAll()
+{
+    for(int slot = 0; slot < animations.size(); ++slot)
+        if(animations[slot].vex){
+            animations[slot].vex->applyPopOut(1, animations[slot].withNameTag);
+            release(slot);
+        }
+}
+
+void animationDriver::release(int slot)
+{
+    animations[slot].vex->animationSlot = -1;
+    animations[slot].vex = nullptr;
+    freeSlots.push_back(slot);
+    if(--activeNum == 0)
+        timer.stop();
+}
+
+/**
+ * @brief animationDriver::handleTick 推进所有进行中的动画
+ */
+void animationDriver::handleTick()
+{
+    qint64 now = clock.elapsed();
+    for(int slot = 0; slot < animations.size(); ++slot){
+        animation& a = animations[slot];
+        if(!a.vex)
+            continue;
+        qreal progress = qreal(now - a.startTime) / duration;
+        if(progress >= 1){
+            a.vex->applyPopOut(1, a.withNameTag);
+            release(slot);
+        }
+        else
+            a.vex->applyPopOut(progress, a.withNameTag);
+    }
+}
+
+/**
+ * @brief animationDriver::setEnabled 开启/关闭动画，关闭时进行中的动画立即结束
+ * @param _enabled 是否开启
+ */
+void animationDriver::setEnabled(bool _enabled)
+{
+    enabled = _enabled;
+    if(!enabled)
+        stopAll();
+}
+
+bool animationDriver::isEnabled() const
+{
+    return enabled;
+}
+
+int animationDriver::getActiveNum() const
+{
+    return activeNum;
+}
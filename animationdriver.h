@@ -0,0 +1,55 @@
+#ifndef ANIMATIONDRIVER_H
+#define ANIMATIONDRIVER_H
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+
+// 二叉树的可视化结点
+class graphicsVexItem;
+
+// 结点动画的统一驱动
+// 所有进行中的动画共用一个定时器，状态存放在可复用的槽位中，结束后槽位归还；
+// 同一结点再次触发时复用原槽位并从头播放
+class animationDriver: public QObject
+{
+    Q_OBJECT
+
+private:
+    // 一个动画槽位
+    struct animation
+    {
+        graphicsVexItem* vex = nullptr;     // 为空表示槽位空闲
+        qint64 startTime = 0;               // 开始的时刻（毫秒）
+        bool withNameTag = false;           // 是否同时淡入名称
+    };
+
+    QTimer timer;
+    QElapsedTimer clock;
+    QVector<animation> animations;
+    QVector<int> freeSlots;     // 空闲槽位的下标
+    int activeNum = 0;          // 进行中的动画数
+    int duration;               // 每个动画的时长（毫秒）
+    bool enabled = true;
+
+    void handleTick();
+    void release(int slot);
+
+public:
+    explicit animationDriver(int _duration = 300, QObject* parent = nullptr);
+
+    // 开始/重新开始结点的弹出动画
+    void start(graphicsVexItem* vex, bool withNameTag);
+    // 立即结束结点的动画（结点销毁前须调用）
+    void stop(graphicsVexItem* vex);
+    // 立即结束所有动画
+    void stopAll();
+
+    // 关闭后新动画直接跳到结束状态
+    void setEnabled(bool _enabled);
+    bool isEnabled() const;
+
+    int getActiveNum() const;
+};
+
+#endif // ANIMATIONDRIVER_H
@@ -0,0 +1,113 @@
+#include "allocationcounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    // 每块内存前的长度头，保持最大对齐
+    const std::size_t headerSize = 16;
+
+    std::atomic<std::size_t> allocNum(0);
+    std::atomic<std::size_t> freeNum(0);
+    std::atomic<std::size_t> allocBytes(0);
+    std::atomic<std::size_t> liveBytes(0);
+    std::atomic<std::size_t> baseBytes(0);
+    std::atomic<std::size_t> peakBytes(0);
+
+    void* allocate(std::size_t size)
+    {
+        char* block = static_cast<char*>(std::malloc(size + headerSize));
+        if(!block)
+            return nullptr;
+        *reinterpret_cast<std::size_t*>(block) = size;
+
+        allocNum.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        std::size_t live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        std::size_t peak = peakBytes.load(std::memory_order_relaxed);
+        while(live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            ;
+        return block + headerSize;
+    }
+
+    void* allocateOrThrow(std::size_t size)
+    {
+        void* p;
+        while(!(p = allocate(size))){
+            std::new_handler handler = std::get_new_handler();
+            if(!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+        return p;
+    }
+
+    void deallocate(void* p)
+    {
+        if(!p)
+            return;
+        char* block = static_cast<char*>(p) - headerSize;
+        freeNum.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(*reinterpret_cast<std::size_t*>(block), std::memory_order_relaxed);
+        std::free(block);
+    }
+}
+
+void* operator new(std::size_t size) { return allocateOrThrow(size); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void operator delete(void* p) noexcept { deallocate(p); }
+void operator delete[](void* p) noexcept { deallocate(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { deallocate(p); }
+#ifdef __cpp_sized_deallocation
+void operator delete(void* p, std::size_t) noexcept { deallocate(p); }
+void operator delete[](void* p, std::size_t) noexcept { deallocate(p); }
+#endif
+
+void allocationCounter::reset()
+{
+    allocNum = 0;
+    freeNum = 0;
+    allocBytes = 0;
+    baseBytes = liveBytes.load();
+    peakBytes = baseBytes.load();
+}
+
+allocationCounter::statistics allocationCounter::get()
+{
+    statistics s;
+    s.allocNum = allocNum;
+    s.freeNum = freeNum;
+    s.allocBytes = allocBytes;
+    s.peakBytes = peakBytes - baseBytes;
+    return s;
+}
+
+std::size_t allocationCounter::peakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return std::size_t(usage.ru_maxrss);            // 字节
+#else
+    return std::size_t(usage.ru_maxrss) * 1024;     // KB
+#endif
+#endif
+}
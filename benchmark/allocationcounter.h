@@ -0,0 +1,29 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+/*
+ * 堆分配统计
+ * allocationcounter.cpp替换了全局的operator new/delete，每块内存前附带长度，
+ * 以统计分配次数、分配字节数与堆占用的峰值。
+ */
+namespace allocationCounter
+{
+    struct statistics
+    {
+        std::size_t allocNum;       // 分配次数
+        std::size_t freeNum;        // 释放次数
+        std::size_t allocBytes;     // 累计分配的字节数
+        std::size_t peakBytes;      // reset()之后堆占用相对起点的峰值
+    };
+
+    // 清零计数，以当前占用作为峰值的起点
+    void reset();
+    statistics get();
+
+    // 进程的峰值常驻内存（字节），无法获取时为0
+    std::size_t peakResidentBytes();
+}
+
+#endif // ALLOCATIONCOUNTER_H
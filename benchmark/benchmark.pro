@@ -0,0 +1,27 @@
+#-------------------------------------------------
+#
+# 遍历算法的基准测试（不依赖Qt）
+# qmake && make 后运行 ./treebenchmark --help 查看参数
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = treebenchmark
+
+CONFIG += console c++11
+CONFIG -= qt app_bundle
+
+# 基准测试总是开启优化
+CONFIG -= debug
+CONFIG += release
+
+SOURCES += \
+    main.cpp \
+    benchtree.cpp \
+    allocationcounter.cpp
+
+HEADERS += \
+    benchtree.h \
+    allocationcounter.h
+
+include(../core/core.pri)
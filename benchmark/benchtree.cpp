@@ -0,0 +1,161 @@
+#include "benchtree.h"
+#include <random>
+
+std::size_t benchNode::visitNum = 0;
+
+benchNode* benchNode::getLeftChild() const { return leftChild; }
+benchNode* benchNode::getRightChild() const { return rightChild; }
+enum binaryTreeNode::TAG benchNode::getLeftChildTag() const { return leftChildTag; }
+enum binaryTreeNode::TAG benchNode::getRightChildTag() const { return rightChildTag; }
+benchNode* benchNode::getParentNode() const { return parentNode; }
+benchNode* benchNode::getLeftLink(enum TAG& tag) const { tag = leftChildTag; return leftChild; }
+benchNode* benchNode::getRightLink(enum TAG& tag) const { tag = rightChildTag; return rightChild; }
+
+void benchNode::setLeftChild(binaryTreeNode* _leftChild, enum binaryTreeNode::TAG tag)
+{
+    leftChild = static_cast<benchNode*>(_leftChild);
+    leftChildTag = tag;
+}
+
+void benchNode::setRightChild(binaryTreeNode* _rightChild, enum binaryTreeNode::TAG tag)
+{
+    rightChild = static_cast<benchNode*>(_rightChild);
+    rightChildTag = tag;
+}
+
+void benchNode::setParentNode(binaryTreeNode* _parentNode)
+{
+    parentNode = static_cast<benchNode*>(_parentNode);
+}
+
+void benchNode::visit()
+{
+    ++visitNum;
+}
+
+
+const char* shapeName(TREE_SHAPE shape)
+{
+    static const char* names[SHAPE_NUM] = { "balanced", "random", "left-skewed", "right-skewed", "zigzag" };
+    return names[shape];
+}
+
+void benchTree::link(std::size_t parent, std::size_t child, bool isLeftChild)
+{
+    if(isLeftChild)
+        nodes[parent].setLeftChild(&nodes[child], binaryTreeNode::LINK);
+    else
+        nodes[parent].setRightChild(&nodes[child], binaryTreeNode::LINK);
+    nodes[child].setParentNode(&nodes[parent]);
+}
+
+/**
+ * @brief benchTree::build 按形状重新构造测试树，O(n)
+ * @param shape 形状
+ * @param nodeNum 结点数
+ * @param seed 随机形状的种子
+ */
+void benchTree::build(TREE_SHAPE shape, std::size_t nodeNum, std::uint64_t seed)
+{
+    // 先释放旧树，避免新旧两棵树同时占用内存
+    tree.setRoot(nullptr);
+    std::vector<benchNode>().swap(nodes);
+    array.reset();
+    std::vector<taggedNode>().swap(taggedNodes);
+    nodes.resize(nodeNum);
+    leafNodeNum = height = 0;
+    if(nodeNum == 0)
+        return;
+
+    switch(shape){
+    case BALANCED:
+        // 完全二叉树：i的孩子为2i+1、2i+2
+        for(std::size_t i = 1; i < nodeNum; ++i)
+            link((i - 1) / 2, i, i % 2 == 1);
+        leafNodeNum = nodeNum - nodeNum / 2;
+        for(std::size_t n = nodeNum; n; n >>= 1)
+            ++height;
+        break;
+    case RANDOM:{
+        // 每次随机挑选一个空位挂上新结点
+        std::mt19937_64 engine(seed);
+        std::vector<std::size_t> slots;     // 空位：结点下标*2 + (0左 / 1右)
+        std::vector<std::size_t> depth(nodeNum, 1);
+        slots.reserve(nodeNum + 1);
+        height = 1;
+        slots.push_back(0);
+        slots.push_back(1);
+        for(std::size_t i = 1; i < nodeNum; ++i){
+            std::size_t k = std::uniform_int_distribution<std::size_t>(0, slots.size() - 1)(engine);
+            std::size_t slot = slots[k];
+            slots[k] = slots.back();
+            slots.pop_back();
+            link(slot / 2, i, slot % 2 == 0);
+            depth[i] = depth[slot / 2] + 1;
+            if(depth[i] > height)
+                height = depth[i];
+            slots.push_back(i * 2);
+            slots.push_back(i * 2 + 1);
+        }
+        for(const benchNode& n : nodes)
+            if(!n.getLeftChild() && !n.getRightChild())
+                ++leafNodeNum;
+        break;
+    }
+    case LEFT_SKEWED:
+    case RIGHT_SKEWED:
+    case ZIGZAG:
+        for(std::size_t i = 1; i < nodeNum; ++i)
+            link(i - 1, i, shape == LEFT_SKEWED || (shape == ZIGZAG && i % 2 == 1));
+        leafNodeNum = 1;
+        height = nodeNum;
+        break;
+    default:
+        break;
+    }
+
+    tree.setRoot(&nodes[0]);
+    tree.reserveScratch(height);
+}
+
+/**
+ * @brief benchTree::getArrayTree 按结点的存放顺序构造同形状的arrayTree
+ *        各形状中双亲的下标总小于孩子，依次addChild即得到相同的下标
+ * @return arrayTree
+ */
+arrayTree& benchTree::getArrayTree()
+{
+    if(!array){
+        array.reset(new arrayTree);
+        array->reserve(nodes.size());
+        if(!nodes.empty())
+            array->addNode();
+        for(std::size_t i = 1; i < nodes.size(); ++i){
+            const benchNode* parent = nodes[i].getParentNode();
+            array->addChild(arrayTree::index_type(parent - &nodes[0]), parent->getLeftChild() == &nodes[i]);
+        }
+    }
+    return *array;
+}
+
+/**
+ * @brief benchTree::getTaggedRoot 按结点的存放顺序构造同形状的taggedNode树（不带线索）
+ * @return 根结点
+ */
+taggedNode* benchTree::getTaggedRoot()
+{
+    if(nodes.empty())
+        return nullptr;
+    if(taggedNodes.empty()){
+        taggedNodes.resize(nodes.size());
+        const benchNode* base = &nodes[0];
+        for(std::size_t i = 0; i < nodes.size(); ++i){
+            const benchNode& n = nodes[i];
+            taggedNode& t = taggedNodes[i];
+            t.leftLink.set(n.getLeftChild() ? &taggedNodes[n.getLeftChild() - base] : nullptr, binaryTreeNode::LINK);
+            t.rightLink.set(n.getRightChild() ? &taggedNodes[n.getRightChild() - base] : nullptr, binaryTreeNode::LINK);
+            t.parentNode = n.getParentNode() ? &taggedNodes[n.getParentNode() - base] : nullptr;
+        }
+    }
+    return &taggedNodes[0];
+}
@@ -0,0 +1,71 @@
+#ifndef BENCHTREE_H
+#define BENCHTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "binarytree.h"
+#include "arraytree.h"
+#include "taggednode.h"
+
+// 基准测试用的结点：与界面结点一样经虚函数访问，visit()只计数
+class benchNode: public binaryTreeNode
+{
+    benchNode* leftChild = nullptr, * rightChild = nullptr;
+    benchNode* parentNode = nullptr;
+    enum TAG leftChildTag = LINK, rightChildTag = LINK;
+
+public:
+    static std::size_t visitNum;    // 累计访问次数（用于校验遍历结果）
+
+    virtual benchNode* getLeftChild() const override;
+    virtual benchNode* getRightChild() const override;
+    virtual enum TAG getLeftChildTag() const override;
+    virtual enum TAG getRightChildTag() const override;
+    virtual benchNode* getParentNode() const override;
+    virtual benchNode* getLeftLink(enum TAG& tag) const override;
+    virtual benchNode* getRightLink(enum TAG& tag) const override;
+    virtual void setLeftChild(binaryTreeNode* leftChild, enum binaryTreeNode::TAG tag) override;
+    virtual void setRightChild(binaryTreeNode* rightChild, enum binaryTreeNode::TAG tag) override;
+    virtual void setParentNode(binaryTreeNode* parentNode) override;
+    virtual void visit() override;
+};
+
+
+// 树的形状
+enum TREE_SHAPE { BALANCED, RANDOM, LEFT_SKEWED, RIGHT_SKEWED, ZIGZAG, SHAPE_NUM };
+
+const char* shapeName(TREE_SHAPE shape);
+
+// 结点连续存放的测试树
+// 直接设置孩子与双亲，不经binaryTree::insertChild（其O(深度)的统计更新会使斜树的构造退化为O(n^2)），
+// 因此结点上的子树统计信息无效，树高在构造时另行求出，并据此预留遍历的暂存区
+class benchTree
+{
+public:
+    void build(TREE_SHAPE shape, std::size_t nodeNum, std::uint64_t seed);
+
+    binaryTree& getTree() { return tree; }
+    std::size_t size() const { return nodes.size(); }
+    std::size_t getLeafNodeNum() const { return leafNodeNum; }
+    std::size_t getHeight() const { return height; }
+
+    // 同形状的arrayTree（下标与结点的存放顺序相同），首次调用时构造
+    arrayTree& getArrayTree();
+
+    // 同形状的taggedNode树（标记存放在孩子指针中），首次调用时构造，空树返回nullptr
+    taggedNode* getTaggedRoot();
+
+private:
+    std::vector<benchNode> nodes;
+    binaryTree tree;
+    std::size_t leafNodeNum = 0;
+    std::size_t height = 0;
+    std::unique_ptr<arrayTree> array;
+    std::vector<taggedNode> taggedNodes;
+
+    void link(std::size_t parent, std::size_t child, bool isLeftChild);
+};
+
+#endif // BENCHTREE_H
@@ -0,0 +1,322 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "arraytree.h"
+#include "tidylayout.h"
+#include "traversaltrace.h"
+#include "treestatistics.h"
+
+/*
+ * 核心算法的正确性检查
+ * 每项检查在若干形状与规模的随机树上，把优化后的实现与直接的暴力实现逐一对照，
+ * 不一致时打印第一处差异；全部通过时返回0。
+ */
+
+namespace
+{
+    typedef arrayTree::index_type index_type;
+
+    // 逐个挂上新结点：每次随机挑选一个空位（skew为0时），或总挂在最后一个结点的同一侧（skew为1/2时为左/右斜树）
+    class randomGrower
+    {
+    public:
+        randomGrower(arrayTree& _tree, std::uint64_t seed, int _skew = 0):
+            tree(_tree), engine(seed), skew(_skew)
+        {
+        }
+
+        // 新增一个结点并返回其下标，第一次调用新建根结点
+        index_type grow()
+        {
+            if(tree.size() == 0){
+                index_type root = tree.addNode();
+                slots.push_back(std::size_t(root) * 2);
+                slots.push_back(std::size_t(root) * 2 + 1);
+                return root;
+            }
+            std::size_t slot;
+            if(skew)
+                slot = (tree.size() - 1) * 2 + std::size_t(skew - 1);
+            else{
+                std::size_t k = std::uniform_int_distribution<std::size_t>(0, slots.size() - 1)(engine);
+                slot = slots[k];
+                slots[k] = slots.back();
+                slots.pop_back();
+            }
+            index_type n = tree.addChild(index_type(slot / 2), slot % 2 == 0);
+            slots.push_back(std::size_t(n) * 2);
+            slots.push_back(std::size_t(n) * 2 + 1);
+            return n;
+        }
+
+    private:
+        arrayTree& tree;
+        std::mt19937_64 engine;
+        int skew;
+        std::vector<std::size_t> slots;     // 空位：结点下标*2 + (0左 / 1右)
+    };
+
+    typedef tidyLayout<arrayTreeAccess> arrayLayout;
+
+    struct position
+    {
+        float x, y;
+    };
+
+    // 暴力检查布局：孩子在双亲的对应一侧，同一层的结点按中序从左到右且相邻间距不小于siblingSeparation
+    bool isTidy(arrayTree& tree, const std::vector<position>& pos, float siblingSeparation, std::size_t& bad)
+    {
+        const float eps = 1e-3f;
+        std::vector<std::vector<index_type> > levels;
+        std::vector<std::size_t> depth(tree.size(), 0);
+        bool ok = true;
+        // 按前序求层号（双亲先于孩子），并检查孩子在双亲的对应一侧
+        tree.traversal<preOrder>([&](index_type n){
+            index_type p = tree.getParentNode(n);
+            depth[n] = p == arrayTree::nil ? 0 : depth[p] + 1;
+            if(p != arrayTree::nil){
+                bool isLeft = tree.getLeftChild(p) == n;
+                if(std::fabs(pos[n].y - pos[p].y - 1) > eps || (isLeft ? pos[n].x >= pos[p].x : pos[n].x <= pos[p].x)){
+                    if(ok)
+                        bad = n;
+                    ok = false;
+                }
+            }
+        });
+        tree.traversal<inOrder>([&](index_type n){
+            if(depth[n] >= levels.size())
+                levels.resize(depth[n] + 1);
+            levels[depth[n]].push_back(n);
+        });
+        for(const std::vector<index_type>& level : levels)
+            for(std::size_t i = 1; i < level.size(); ++i)
+                if(pos[level[i]].x - pos[level[i - 1]].x < siblingSeparation - eps){
+                    if(ok)
+                        bad = level[i];
+                    ok = false;
+                }
+        return ok;
+    }
+
+    /**
+     * @brief checkIncrementalLayout 逐个插入结点并增量布局，与对整棵树重新布局的结果及暴力检查对照
+     * @param nodeNum 结点数
+     * @param every 每插入every个结点对照一次（最后一次总对照）
+     * @return 是否一致
+     */
+    bool checkIncrementalLayout(const char* name, std::size_t nodeNum, std::size_t every, std::uint64_t seed, int skew)
+    {
+        arrayTree tree;
+        tree.reserve(nodeNum);
+        randomGrower grower(tree, seed, skew);
+        arrayLayout incremental{arrayTreeAccess(&tree)};
+        std::vector<position> pos(nodeNum), fullPos(nodeNum);
+        auto moved = [&pos](index_type n, float x, float y){ pos[n] = position{x, y}; };
+
+        incremental.layout(grower.grow(), moved);
+        for(std::size_t i = 1; i < nodeNum; ++i){
+            incremental.insert(grower.grow(), moved);
+            if(i % every != 0 && i + 1 != nodeNum)
+                continue;
+
+            arrayLayout full{arrayTreeAccess(&tree)};
+            full.layout(tree.getRoot(), [&fullPos](index_type n, float x, float y){ fullPos[n] = position{x, y}; });
+            for(std::size_t n = 0; n <= i; ++n){
+                if(std::fabs(pos[n].x - fullPos[n].x) > 1e-3f * (1 + std::fabs(fullPos[n].x)) || pos[n].y != fullPos[n].y){
+                    std::printf("FAILED  tidyLayout::insert on %s tree: after %zu nodes, node %zu is at (%g, %g), full layout gives (%g, %g)\n",
+                                name, i + 1, n, pos[n].x, pos[n].y, fullPos[n].x, fullPos[n].y);
+                    return false;
+                }
+            }
+            std::size_t bad = 0;
+            if(!isTidy(tree, pos, 1, bad)){
+                std::printf("FAILED  tidyLayout on %s tree: after %zu nodes, node %zu overlaps or is on the wrong side\n", name, i + 1, bad);
+                return false;
+            }
+        }
+        std::printf("ok      tidyLayout::insert on %s tree of %zu nodes\n", name, nodeNum);
+        return true;
+    }
+
+    // 暴力统计：逐个结点比较孩子下标与nil、读取标记
+    treeStatistics countStatistics(const arrayTree& tree)
+    {
+        treeStatistics s;
+        s.nodeNum = tree.size();
+        for(index_type n = 0; n < tree.size(); ++n){
+            bool leftThread = tree.getLeftChildTag(n) == binaryTreeNode::THREAD;
+            bool rightThread = tree.getRightChildTag(n) == binaryTreeNode::THREAD;
+            bool leftNull = tree.getLeftChild(n) == arrayTree::nil;
+            bool rightNull = tree.getRightChild(n) == arrayTree::nil;
+            s.leftThreadNum += leftThread;
+            s.rightThreadNum += rightThread;
+            s.leftNullNum += leftNull;
+            s.rightNullNum += rightNull;
+            s.leafNum += (leftNull || leftThread) && (rightNull || rightThread);
+        }
+        return s;
+    }
+
+    void printStatistics(const char* title, const treeStatistics& s)
+    {
+        std::printf("        %-8s nodes %llu, leaves %llu, threads %llu/%llu, nulls %llu/%llu\n", title,
+                    (unsigned long long)s.nodeNum, (unsigned long long)s.leafNum,
+                    (unsigned long long)s.leftThreadNum, (unsigned long long)s.rightThreadNum,
+                    (unsigned long long)s.leftNullNum, (unsigned long long)s.rightNullNum);
+    }
+
+    // 对本机支持的每一级指令集，比较scanStatistics与暴力统计，并比较叶子数与countLeafNode
+    bool compareStatistics(arrayTree& tree, const char* state)
+    {
+        treeStatistics expected = countStatistics(tree);
+        std::size_t leafNum = tree.countLeafNode();
+        if(expected.leafNum != leafNum){
+            std::printf("FAILED  treeStatistics on %zu nodes (%s): brute-force leaves %llu, countLeafNode %zu\n",
+                        tree.size(), state, (unsigned long long)expected.leafNum, leafNum);
+            return false;
+        }
+        for(int level = SCALAR_LEVEL; level <= detectSimdLevel(); ++level){
+            treeStatistics actual = tree.scanStatistics(SIMD_LEVEL(level));
+            if(actual != expected){
+                std::printf("FAILED  treeStatistics on %zu nodes (%s) with %s:\n", tree.size(), state, simdLevelName(SIMD_LEVEL(level)));
+                printStatistics("scan", actual);
+                printStatistics("expected", expected);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief checkStatistics 在未线索化及按三种次序线索化的随机树上检查向量化统计
+     * @param nodeNum 结点数（取64的倍数附近以覆盖尾部不满一个字的情况）
+     * @return 是否一致
+     */
+    bool checkStatistics(std::size_t nodeNum, std::uint64_t seed)
+    {
+        arrayTree tree;
+        tree.reserve(nodeNum);
+        randomGrower grower(tree, seed);
+        for(std::size_t i = 0; i < nodeNum; ++i)
+            grower.grow();
+
+        auto ignore = [](index_type){};
+        bool ok = compareStatistics(tree, "unthreaded");
+        tree.createThreadedTree<preOrder>(ignore);
+        ok = ok && compareStatistics(tree, "preorder threads");
+        tree.clearThreadedTree();
+        tree.createThreadedTree<inOrder>(ignore);
+        ok = ok && compareStatistics(tree, "inorder threads");
+        tree.clearThreadedTree();
+        tree.createThreadedTree<postOrder>(ignore);
+        ok = ok && compareStatistics(tree, "postorder threads");
+        tree.clearThreadedTree();
+        ok = ok && compareStatistics(tree, "threads cleared");
+        if(ok)
+            std::printf("ok      treeStatistics on random tree of %zu nodes (scalar to %s)\n", nodeNum, simdLevelName(detectSimdLevel()));
+        return ok;
+    }
+
+    /**
+     * @brief checkTrace 记录eventNum个随机事件，在每个位置上比较轨迹的查询与从头逐个回放的结果
+     * @param nodeNum 结点数（决定检查点间隔）
+     * @param eventNum 事件数
+     * @return 是否一致
+     */
+    bool checkTrace(std::size_t nodeNum, std::size_t eventNum, std::uint64_t seed)
+    {
+        typedef traversalTrace::index_type value_type;
+        std::mt19937_64 engine(seed);
+        std::uniform_int_distribution<value_type> node(0, value_type(nodeNum - 1)), kind(0, 9);
+        traversalTrace trace;
+        trace.clear(nodeNum);
+        for(std::size_t i = 0; i < eventNum; ++i){
+            value_type k = kind(engine);
+            if(k < 7)
+                trace.addVisit(node(engine));
+            else if(k < 9)
+                trace.addThread(node(engine), node(engine), k == 7);
+            else
+                trace.addMarker(node(engine));
+        }
+
+        // 回放：expected为前position个事件生效后的状态
+        std::vector<std::uint64_t> expected((nodeNum + 63) / 64, 0), parity;
+        std::size_t threadNum = 0;
+        bool hasMarker = false;
+        value_type marker = 0;
+        for(std::size_t position = 0; ; ++position){
+            value_type value = 0;
+            bool found = trace.lastMarkerBefore(position, value);
+            trace.parityBefore(position, parity);
+            const char* wrong = nullptr;
+            if(parity != expected)
+                wrong = "parityBefore";
+            else if(trace.threadNumBefore(position) != threadNum)
+                wrong = "threadNumBefore";
+            else if(found != hasMarker || (found && value != marker))
+                wrong = "lastMarkerBefore";
+            if(wrong){
+                std::printf("FAILED  traversalTrace::%s with %zu nodes and %zu events (interval %zu) at position %zu\n",
+                            wrong, nodeNum, eventNum, trace.getCheckpointInterval(), position);
+                return false;
+            }
+            if(position == trace.size())
+                break;
+
+            value_type v = trace.getValue(position);
+            switch(trace.getKind(position)){
+                case traversalTrace::VISIT: expected[v >> 6] ^= std::uint64_t(1) << (v & 63); break;
+                case traversalTrace::LEFT_THREAD:
+                case traversalTrace::RIGHT_THREAD: ++threadNum; break;
+                case traversalTrace::MARKER: hasMarker = true; marker = v; break;
+            }
+        }
+        // 超出末尾的位置按末尾处理
+        trace.parityBefore(trace.size() + 1, parity);
+        if(parity != expected){
+            std::printf("FAILED  traversalTrace::parityBefore with %zu nodes and %zu events past the end\n", nodeNum, eventNum);
+            return false;
+        }
+        return true;
+    }
+
+    // 事件数取检查点间隔的整数倍及其前后，覆盖恰在检查点上与末尾检查点尚未记录的情况
+    bool checkTraceQueries(std::size_t nodeNum)
+    {
+        traversalTrace probe;
+        probe.clear(nodeNum);
+        std::size_t interval = probe.getCheckpointInterval();
+        bool ok = true;
+        for(std::size_t eventNum : {std::size_t(0), std::size_t(1), interval - 1, interval, interval + 1,
+                                    3 * interval - 1, 3 * interval, 3 * interval + 1})
+            ok = ok && checkTrace(nodeNum, eventNum, nodeNum * 31 + eventNum);
+        if(ok)
+            std::printf("ok      traversalTrace queries with %zu nodes (interval %zu)\n", nodeNum, interval);
+        return ok;
+    }
+}
+
+int main()
+{
+    bool isAllCorrect = true;
+
+    // 增量布局：小树每次插入后都对照，大树每隔一段对照
+    for(std::uint64_t seed = 1; seed <= 5; ++seed)
+        isAllCorrect &= checkIncrementalLayout("random", 300, 1, seed, 0);
+    isAllCorrect &= checkIncrementalLayout("left-skewed", 300, 1, 1, 1);
+    isAllCorrect &= checkIncrementalLayout("right-skewed", 300, 1, 1, 2);
+    isAllCorrect &= checkIncrementalLayout("random", 20000, 997, 7, 0);
+
+    // 向量化统计：各级指令集与暴力统计对照，规模覆盖空树、单结点与64的倍数前后
+    for(std::size_t nodeNum : {0, 1, 2, 63, 64, 65, 127, 1000, 100003})
+        isAllCorrect &= checkStatistics(nodeNum, nodeNum + 11);
+
+    // 遍历轨迹：每个位置的奇偶性、线索数与标记都与从头回放一致
+    for(std::size_t nodeNum : {1, 2, 63, 64, 65, 1000, 5000, 20000})
+        isAllCorrect &= checkTraceQueries(nodeNum);
+
+    std::printf(isAllCorrect ? "all checks passed\n" : "some checks FAILED\n");
+    return isAllCorrect ? 0 : 1;
+}
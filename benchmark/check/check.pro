@@ -0,0 +1,17 @@
+#-------------------------------------------------
+#
+# 核心算法的正确性检查（不依赖Qt）：与直接的暴力实现逐一对照
+# qmake && make 后运行 ./treecheck，全部通过时返回0
+#
+#-------------------------------------------------
+
+TEMPLATE = app
+TARGET = treecheck
+
+CONFIG += console c++11
+CONFIG -= qt app_bundle
+
+SOURCES += \
+    check.cpp
+
+include(../../core/core.pri)
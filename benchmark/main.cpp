@@ -0,0 +1,518 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "binarytree.h"
+#include "parallelreduce.h"
+#include "taggednode.h"
+#include "benchtree.h"
+#include "allocationcounter.h"
+
+/*
+ * 遍历算法的基准测试
+ * 对每种形状、每个规模的树，依次测量binaryTree的全部遍历（栈 / 线索 / Morris / 层序）、
+ * 线索化与清除线索、叶子计数，均不带动画延迟。
+ * 每项先不计时地运行一次（预热缓存），再重复运行直至累计时间超过--min-time，
+ * 报告每结点耗时（最优与中位数）、单次运行的堆分配次数与字节数、堆占用峰值，以及进程的峰值常驻内存。
+ * 线索遍历前的线索化、线索化后的清除等准备工作不计时也不计入分配统计。
+ * stackTraversal/burst连续运行--burst次栈式遍历（依次为前/中/后序），
+ * 暂存区已按树高预留，稳态下不应有任何堆分配，否则视为错误。
+ * levelOrderParallel按层并行地层序遍历（--threads个工作线程）；两种层序遍历的队列按层宽的上界预留，
+ * 同样不应有堆分配；
+ * 指定--levels时，另对两种层序遍历各运行一次，逐层报告宽度与耗时。
+ * treeStatistics/scalar、avx2、avx512在同形状的arrayTree上顺序扫描数组求叶子数、线索数与空孩子数，
+ * 与countLeafNode（经虚函数）及countLeafNode/array（arrayTree上的遍历）对照；本机不支持的指令集跳过。
+ * *_Thr/tag在同形状的taggedNode树（标记存放在孩子指针的最低位，每结点24字节）上做线索遍历，
+ * 与经虚函数分别读取孩子与标记的*_Thr对照，线索化与清除同样不计时。
+ */
+
+namespace
+{
+    const char* const schema = "bintree-bench/1";
+    const char* const levelSchema = "bintree-bench-levels/1";
+    const std::size_t maxLevelRows = 64;
+
+    enum OPERATION_KIND { TRAVERSE, CREATE_THREADED, CLEAR_THREADED, COUNT_LEAF, BACK_TO_BACK, PARALLEL_LEVEL,
+                          COUNT_LEAF_ARRAY, SCAN_STATISTICS, TAGGED_THREADED };
+
+    struct benchOperation
+    {
+        const char* name;
+        OPERATION_KIND kind;
+        int mode;
+        int method;
+    };
+
+    const benchOperation operations[] = {
+        { "preOrderTraversal",          TRAVERSE,        binaryTree::PREORDER_TRAVERSAL,  binaryTree::STACK_TRAVERSAL },
+        { "inOrderTraversal",           TRAVERSE,        binaryTree::INORDER_TRAVERSAL,   binaryTree::STACK_TRAVERSAL },
+        { "postOrderTraversal",         TRAVERSE,        binaryTree::POSTORDER_TRAVERSAL, binaryTree::STACK_TRAVERSAL },
+        { "preOrderTraversal_Thr",      TRAVERSE,        binaryTree::PREORDER_TRAVERSAL,  binaryTree::THREADED_TRAVERSAL },
+        { "inOrderTraversal_Thr",       TRAVERSE,        binaryTree::INORDER_TRAVERSAL,   binaryTree::THREADED_TRAVERSAL },
+        { "postOrderTraversal_Thr",     TRAVERSE,        binaryTree::POSTORDER_TRAVERSAL, binaryTree::THREADED_TRAVERSAL },
+        { "preOrderTraversal_Thr/tag",  TAGGED_THREADED, binaryTree::PREORDER_TRAVERSAL,  0 },
+        { "inOrderTraversal_Thr/tag",   TAGGED_THREADED, binaryTree::INORDER_TRAVERSAL,   0 },
+        { "postOrderTraversal_Thr/tag", TAGGED_THREADED, binaryTree::POSTORDER_TRAVERSAL, 0 },
+        { "preOrderTraversal_Morris",   TRAVERSE,        binaryTree::PREORDER_TRAVERSAL,  binaryTree::MORRIS_TRAVERSAL },
+        { "inOrderTraversal_Morris",    TRAVERSE,        binaryTree::INORDER_TRAVERSAL,   binaryTree::MORRIS_TRAVERSAL },
+        { "postOrderTraversal_Morris",  TRAVERSE,        binaryTree::POSTORDER_TRAVERSAL, binaryTree::MORRIS_TRAVERSAL },
+        { "levelOrderTraversal",        TRAVERSE,        binaryTree::LEVELORDER_TRAVERSAL, binaryTree::STACK_TRAVERSAL },
+        { "levelOrderParallel",         PARALLEL_LEVEL,  binaryTree::LEVELORDER_TRAVERSAL, 0 },
+        { "createThreadedTree/pre",     CREATE_THREADED, binaryTree::PREORDER_TRAVERSAL,  0 },
+        { "createThreadedTree/in",      CREATE_THREADED, binaryTree::INORDER_TRAVERSAL,   0 },
+        { "createThreadedTree/post",    CREATE_THREADED, binaryTree::POSTORDER_TRAVERSAL, 0 },
+        { "clearThreadedTree/pre",      CLEAR_THREADED,  binaryTree::PREORDER_TRAVERSAL,  0 },
+        { "clearThreadedTree/in",       CLEAR_THREADED,  binaryTree::INORDER_TRAVERSAL,   0 },
+        { "clearThreadedTree/post",     CLEAR_THREADED,  binaryTree::POSTORDER_TRAVERSAL, 0 },
+        { "countLeafNode",              COUNT_LEAF,      0,                               0 },
+        { "countLeafNode/array",        COUNT_LEAF_ARRAY, 0,                              0 },
+        { "treeStatistics/scalar",      SCAN_STATISTICS, 0,                               SCALAR_LEVEL },
+        { "treeStatistics/avx2",        SCAN_STATISTICS, 0,                               AVX2_LEVEL },
+        { "treeStatistics/avx512",      SCAN_STATISTICS, 0,                               AVX512_LEVEL },
+        { "stackTraversal/burst",       BACK_TO_BACK,    0,                               binaryTree::STACK_TRAVERSAL },
+    };
+
+    enum OUTPUT_FORMAT { TABLE, CSV, JSON };
+
+    struct benchOptions
+    {
+        std::vector<std::size_t> sizes;
+        std::vector<TREE_SHAPE> shapes;
+        std::string filter;             // 只运行名称包含该子串的项目
+        double minTime = 0.2;           // 每项的最短累计运行时间（秒）
+        std::size_t maxReps = 1000;
+        std::size_t burst = 1000;       // stackTraversal/burst的遍历次数
+        unsigned threadNum = std::thread::hardware_concurrency();
+        bool isLevelProfiled = false;   // 是否逐层报告层序遍历的耗时
+        std::uint64_t seed = 1;
+        OUTPUT_FORMAT format = TABLE;
+    };
+
+    typedef concreteNodeAccess<benchNode> benchAccess;
+
+    // taggedNode树上的线索化与线索遍历
+    treeTraversal<taggedNodeAccess> taggedAlgorithm;
+
+    // 在taggedNode树上按mode线索遍历，返回访问的结点数
+    std::size_t taggedTraversal_Thr(taggedNode* root, int mode)
+    {
+        std::size_t visitNum = 0;
+        auto counter = [&visitNum](taggedNode*){ ++visitNum; };
+        switch(mode){
+            case binaryTree::PREORDER_TRAVERSAL: taggedAlgorithm.traversal_Thr<preOrder>(root, counter); break;
+            case binaryTree::INORDER_TRAVERSAL: taggedAlgorithm.traversal_Thr<inOrder>(root, counter); break;
+            case binaryTree::POSTORDER_TRAVERSAL: taggedAlgorithm.traversal_Thr<postOrder>(root, counter); break;
+        }
+        return visitNum;
+    }
+
+    void createTaggedThreadedTree(taggedNode* root, int mode)
+    {
+        auto ignore = [](taggedNode*){};
+        switch(mode){
+            case binaryTree::PREORDER_TRAVERSAL: taggedAlgorithm.createThreadedTree<preOrder>(root, ignore); break;
+            case binaryTree::INORDER_TRAVERSAL: taggedAlgorithm.createThreadedTree<inOrder>(root, ignore); break;
+            case binaryTree::POSTORDER_TRAVERSAL: taggedAlgorithm.createThreadedTree<postOrder>(root, ignore); break;
+        }
+    }
+
+    // 按层并行的层序遍历及其各工作线程的访问计数
+    struct parallelLevelBench
+    {
+        struct paddedCount
+        {
+            std::size_t visitNum;
+            char padding[64 - sizeof(std::size_t)];     // 避免相邻线程的计数共享缓存行
+        };
+
+        threadPool pool;
+        parallelLevelTraversal<benchAccess> traversal;
+        std::vector<paddedCount> counts;
+
+        explicit parallelLevelBench(unsigned threadNum):
+            pool(threadNum),
+            traversal(pool),
+            counts(pool.size())
+        {
+        }
+
+        template<class LevelHook>
+        std::size_t run(binaryTree& tree, LevelHook onLevel)
+        {
+            for(paddedCount& c : counts)
+                c.visitNum = 0;
+            traversal.traverse(static_cast<benchNode*>(tree.getRoot()),
+                               [this](benchNode*, unsigned id){ ++counts[id].visitNum; }, onLevel);
+            std::size_t visitNum = 0;
+            for(const paddedCount& c : counts)
+                visitNum += c.visitNum;
+            return visitNum;
+        }
+    };
+
+    struct benchResult
+    {
+        std::size_t reps;
+        double bestNsPerNode;
+        double medianNsPerNode;
+        allocationCounter::statistics alloc;    // 单次运行中的最大值
+        std::size_t peakRssBytes;
+    };
+
+    void printUsage(const char* program)
+    {
+        std::fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --sizes=N,...      node counts, e.g. 1e3,1e6 (default 1e3,1e4,1e5,1e6,1e7)\n"
+            "                     each node takes %u bytes (plus 12.25 for the arrayTree operations\n"
+            "                     and %u for the tagged ones), 1e8 needs about %.1f GB\n"
+            "  --shapes=S,...     balanced,random,left-skewed,right-skewed,zigzag (default all)\n"
+            "  --filter=TEXT      only operations whose name contains TEXT\n"
+            "  --min-time=SEC     minimum accumulated time per operation (default 0.2)\n"
+            "  --max-reps=N       maximum repetitions per operation (default 1000)\n"
+            "  --burst=N          traversals per stackTraversal/burst run, capped at 1e8 visited nodes (default 1000)\n"
+            "  --threads=N        worker threads of the parallel level-order traversal (default all cores)\n"
+            "  --levels           report width and time of every level of both level-order traversals\n"
+            "                     (table and json only; deep trees are grouped into at most 64 rows)\n"
+            "  --seed=N           seed of the random shape (default 1)\n"
+            "  --format=F         table, csv or json (one object per line; default table)\n",
+            program, unsigned(sizeof(benchNode)), unsigned(sizeof(taggedNode)),
+            (sizeof(benchNode) + 12.25 + sizeof(taggedNode)) * 1e8 / 1e9);
+    }
+
+    bool startsWith(const char* arg, const char* prefix, const char*& value)
+    {
+        std::size_t n = std::strlen(prefix);
+        if(std::strncmp(arg, prefix, n) != 0)
+            return false;
+        value = arg + n;
+        return true;
+    }
+
+    std::vector<std::string> split(const char* list)
+    {
+        std::vector<std::string> items;
+        std::string item;
+        for(const char* p = list; ; ++p){
+            if(*p == ',' || *p == '\0'){
+                if(!item.empty())
+                    items.push_back(item);
+                item.clear();
+                if(*p == '\0')
+                    break;
+            }
+            else
+                item += *p;
+        }
+        return items;
+    }
+
+    bool parseOptions(int argc, char* argv[], benchOptions& options)
+    {
+        for(int i = 1; i < argc; ++i){
+            const char* value;
+            if(startsWith(argv[i], "--sizes=", value)){
+                options.sizes.clear();
+                for(const std::string& s : split(value)){
+                    char* end;
+                    double n = std::strtod(s.c_str(), &end);      // 接受1e6这样的写法
+                    if(*end != '\0' || n < 1){
+                        std::fprintf(stderr, "invalid size: %s\n", s.c_str());
+                        return false;
+                    }
+                    options.sizes.push_back(std::size_t(n));
+                }
+            }
+            else if(startsWith(argv[i], "--shapes=", value)){
+                options.shapes.clear();
+                for(const std::string& s : split(value)){
+                    int shape = 0;
+                    while(shape < SHAPE_NUM && s != shapeName(TREE_SHAPE(shape)))
+                        ++shape;
+                    if(shape == SHAPE_NUM){
+                        std::fprintf(stderr, "unknown shape: %s\n", s.c_str());
+                        return false;
+                    }
+                    options.shapes.push_back(TREE_SHAPE(shape));
+                }
+            }
+            else if(startsWith(argv[i], "--filter=", value))
+                options.filter = value;
+            else if(startsWith(argv[i], "--min-time=", value))
+                options.minTime = std::atof(value);
+            else if(startsWith(argv[i], "--max-reps=", value))
+                options.maxReps = std::size_t(std::strtoull(value, nullptr, 10));
+            else if(startsWith(argv[i], "--burst=", value))
+                options.burst = std::size_t(std::strtoull(value, nullptr, 10));
+            else if(startsWith(argv[i], "--threads=", value))
+                options.threadNum = unsigned(std::strtoul(value, nullptr, 10));
+            else if(std::strcmp(argv[i], "--levels") == 0)
+                options.isLevelProfiled = true;
+            else if(startsWith(argv[i], "--seed=", value))
+                options.seed = std::strtoull(value, nullptr, 10);
+            else if(startsWith(argv[i], "--format=", value)){
+                if(std::strcmp(value, "table") == 0)
+                    options.format = TABLE;
+                else if(std::strcmp(value, "csv") == 0)
+                    options.format = CSV;
+                else if(std::strcmp(value, "json") == 0)
+                    options.format = JSON;
+                else{
+                    std::fprintf(stderr, "unknown format: %s\n", value);
+                    return false;
+                }
+            }
+            else
+                return false;
+        }
+
+        if(options.sizes.empty())
+            options.sizes = { 1000, 10000, 100000, 1000000, 10000000 };
+        if(options.shapes.empty())
+            for(int shape = 0; shape < SHAPE_NUM; ++shape)
+                options.shapes.push_back(TREE_SHAPE(shape));
+        if(options.maxReps < 1)
+            options.maxReps = 1;
+        if(options.burst < 1)
+            options.burst = 1;
+        if(options.threadNum < 1)
+            options.threadNum = 1;
+        return true;
+    }
+
+    // 不计时的准备工作
+    void prepare(benchTree& bench, const benchOperation& op, parallelLevelBench& parallel)
+    {
+        // 层序遍历按层宽的上界预留队列（测试树上的子树统计无效，binaryTree自行求出的上界不可用）
+        if(op.mode == binaryTree::LEVELORDER_TRAVERSAL){
+            std::size_t width = levelWidthBound(bench.getHeight(), bench.getLeafNodeNum());
+            if(op.kind == PARALLEL_LEVEL)
+                parallel.traversal.reserve(width);
+            else
+                bench.getTree().reserveScratch(bench.getHeight(), width);
+        }
+        else if((op.kind == TRAVERSE && op.method == binaryTree::THREADED_TRAVERSAL) || op.kind == CLEAR_THREADED)
+            bench.getTree().createThreadedTree(op.mode);
+        else if(op.kind == TAGGED_THREADED)
+            createTaggedThreadedTree(bench.getTaggedRoot(), op.mode);
+    }
+
+    void finish(benchTree& bench, const benchOperation& op)
+    {
+        if((op.kind == TRAVERSE && op.method == binaryTree::THREADED_TRAVERSAL) || op.kind == CREATE_THREADED)
+            bench.getTree().clearThreadedTree();
+        else if(op.kind == TAGGED_THREADED)
+            taggedAlgorithm.clearThreadedTree(bench.getTaggedRoot());
+    }
+
+    // stackTraversal/burst一次运行的遍历次数，总访问结点数不超过1e8
+    std::size_t burstOf(const benchOptions& options, std::size_t nodeNum)
+    {
+        std::size_t limit = std::max<std::size_t>(1, 100000000 / std::max<std::size_t>(nodeNum, 1));
+        return std::min(options.burst, limit);
+    }
+
+    // 计时的部分，返回值用于校验
+    std::size_t run(benchTree& bench, const benchOperation& op, std::size_t burst, parallelLevelBench& parallel)
+    {
+        binaryTree& tree = bench.getTree();
+        switch(op.kind){
+        case PARALLEL_LEVEL:
+            return parallel.run(tree, [](std::size_t, std::size_t){});
+        case COUNT_LEAF_ARRAY:
+            return bench.getArrayTree().countLeafNode();
+        case SCAN_STATISTICS:
+            return std::size_t(bench.getArrayTree().scanStatistics(SIMD_LEVEL(op.method)).leafNum);
+        case TAGGED_THREADED:
+            return taggedTraversal_Thr(bench.getTaggedRoot(), op.mode);
+        case BACK_TO_BACK:
+            for(std::size_t i = 0; i < burst; ++i)
+                tree.traverse(int(i % 3), op.method);
+            return benchNode::visitNum;
+        case TRAVERSE:
+            tree.traverse(op.mode, op.method);
+            return benchNode::visitNum;
+        case CREATE_THREADED:
+            tree.createThreadedTree(op.mode);
+            return benchNode::visitNum;
+        case CLEAR_THREADED:
+            tree.clearThreadedTree();
+            return 0;
+        case COUNT_LEAF:
+            return tree.countLeafNode();
+        }
+        return 0;
+    }
+
+    /**
+     * @brief measure 重复运行一项操作直至累计时间足够
+     * @param tree 测试树
+     * @param op 操作
+     * @param result 测量结果
+     * @return 结果是否正确（遍历须访问全部结点，叶子数须与构造时一致）
+     */
+    bool measure(benchTree& tree, const benchOperation& op, const benchOptions& options, parallelLevelBench& parallel, benchResult& result)
+    {
+        typedef std::chrono::steady_clock clock;
+        std::vector<double> samples;
+        double total = 0;
+        bool isCorrect = true;
+        std::size_t burst = op.kind == BACK_TO_BACK ? burstOf(options, tree.size()) : 1;
+        bool isLeafCount = op.kind == COUNT_LEAF || op.kind == COUNT_LEAF_ARRAY || op.kind == SCAN_STATISTICS;
+        std::size_t expected = isLeafCount ? tree.getLeafNodeNum() : tree.size() * burst;
+
+        // 预热缓存（暂存区与队列已在prepare中按所需容量预留）
+        prepare(tree, op, parallel);
+        run(tree, op, burst, parallel);
+        finish(tree, op);
+
+        result.alloc = allocationCounter::statistics{0, 0, 0, 0};
+        while(samples.empty() || (total < options.minTime && samples.size() < options.maxReps)){
+            prepare(tree, op, parallel);
+            benchNode::visitNum = 0;
+            allocationCounter::reset();
+
+            clock::time_point start = clock::now();
+            std::size_t value = run(tree, op, burst, parallel);
+            double seconds = std::chrono::duration<double>(clock::now() - start).count();
+
+            allocationCounter::statistics alloc = allocationCounter::get();
+            result.alloc.allocNum = std::max(result.alloc.allocNum, alloc.allocNum);
+            result.alloc.freeNum = std::max(result.alloc.freeNum, alloc.freeNum);
+            result.alloc.allocBytes = std::max(result.alloc.allocBytes, alloc.allocBytes);
+            result.alloc.peakBytes = std::max(result.alloc.peakBytes, alloc.peakBytes);
+            if(op.kind != CLEAR_THREADED && value != expected)
+                isCorrect = false;
+            if((op.kind == BACK_TO_BACK || op.mode == binaryTree::LEVELORDER_TRAVERSAL) && alloc.allocNum != 0)
+                isCorrect = false;      // 暂存区已预留，不应分配内存
+            finish(tree, op);
+
+            samples.push_back(seconds);
+            total += seconds;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        double n = double(tree.size()) * double(burst);
+        result.reps = samples.size();
+        result.bestNsPerNode = samples.front() * 1e9 / n;
+        result.medianNsPerNode = samples[samples.size() / 2] * 1e9 / n;
+        result.peakRssBytes = allocationCounter::peakResidentBytes();
+        return isCorrect;
+    }
+
+    void printHeader(OUTPUT_FORMAT format)
+    {
+        if(format == TABLE)
+            std::printf("%-13s %10s %-26s %6s %10s %10s %8s %12s %12s %10s\n",
+                        "shape", "nodes", "operation", "reps", "best ns/n", "median", "allocs", "alloc bytes", "peak heap", "peak RSS");
+        else if(format == CSV)
+            std::printf("shape,nodes,operation,reps,best_ns_per_node,median_ns_per_node,allocations,allocated_bytes,peak_heap_bytes,peak_rss_bytes\n");
+    }
+
+    void printResult(OUTPUT_FORMAT format, TREE_SHAPE shape, std::size_t nodeNum, const benchOperation& op, const benchResult& r)
+    {
+        unsigned long long rss = r.peakRssBytes;
+        switch(format){
+        case TABLE:
+            std::printf("%-13s %10zu %-26s %6zu %10.2f %10.2f %8zu %12zu %12zu %8.1fMB\n",
+                        shapeName(shape), nodeNum, op.name, r.reps, r.bestNsPerNode, r.medianNsPerNode,
+                        r.alloc.allocNum, r.alloc.allocBytes, r.alloc.peakBytes, rss / 1048576.0);
+            break;
+        case CSV:
+            std::printf("%s,%zu,%s,%zu,%.4f,%.4f,%zu,%zu,%zu,%llu\n",
+                        shapeName(shape), nodeNum, op.name, r.reps, r.bestNsPerNode, r.medianNsPerNode,
+                        r.alloc.allocNum, r.alloc.allocBytes, r.alloc.peakBytes, rss);
+            break;
+        case JSON:
+            std::printf("{\"schema\":\"%s\",\"shape\":\"%s\",\"nodes\":%zu,\"operation\":\"%s\",\"reps\":%zu,"
+                        "\"bestNsPerNode\":%.4f,\"medianNsPerNode\":%.4f,\"allocations\":%zu,\"allocatedBytes\":%zu,"
+                        "\"peakHeapBytes\":%zu,\"peakRssBytes\":%llu}\n",
+                        schema, shapeName(shape), nodeNum, op.name, r.reps, r.bestNsPerNode, r.medianNsPerNode,
+                        r.alloc.allocNum, r.alloc.allocBytes, r.alloc.peakBytes, rss);
+            break;
+        }
+        std::fflush(stdout);
+    }
+
+    // 对层序遍历运行一次，记录各层的宽度与耗时
+    std::vector<traversalMetrics::levelTiming> profileLevels(binaryTree& tree, const benchOperation& op, parallelLevelBench& parallel)
+    {
+        typedef std::chrono::steady_clock clock;
+        if(op.kind == PARALLEL_LEVEL){
+            traversalMetrics metrics;
+            clock::time_point last = clock::now();
+            parallel.run(tree, [&](std::size_t depth, std::size_t width){
+                clock::time_point now = clock::now();
+                metrics.addLevel(depth, width, std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count()));
+                last = now;
+            });
+            return metrics.levels;
+        }
+        tree.setMetricsEnabled(true);
+        tree.resetMetrics();
+        tree.traverse(op.mode, op.method);
+        tree.setMetricsEnabled(false);
+        return tree.getMetrics().levels;
+    }
+
+    // 逐层输出，层数超过maxLevelRows时把相邻的层合并为一行
+    void printLevels(OUTPUT_FORMAT format, TREE_SHAPE shape, std::size_t nodeNum, const benchOperation& op,
+                     const std::vector<traversalMetrics::levelTiming>& levels)
+    {
+        std::size_t group = (levels.size() + maxLevelRows - 1) / maxLevelRows;
+        for(std::size_t first = 0; first < levels.size(); first += group){
+            std::size_t last = std::min(first + group, levels.size()) - 1;
+            unsigned long long width = 0, ns = 0;
+            for(std::size_t d = first; d <= last; ++d){
+                width += levels[d].width;
+                ns += levels[d].nanoseconds;
+            }
+            if(format == TABLE)
+                std::printf("  %-26s depth %7zu-%-7zu width %10llu %12.3f ms %10.2f ns/n\n",
+                            op.name, first, last, width, ns / 1e6, width ? double(ns) / double(width) : 0.0);
+            else if(format == JSON)
+                std::printf("{\"schema\":\"%s\",\"shape\":\"%s\",\"nodes\":%zu,\"operation\":\"%s\","
+                            "\"firstDepth\":%zu,\"lastDepth\":%zu,\"width\":%llu,\"nanoseconds\":%llu}\n",
+                            levelSchema, shapeName(shape), nodeNum, op.name, first, last, width, ns);
+        }
+        std::fflush(stdout);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    benchOptions options;
+    if(!parseOptions(argc, argv, options)){
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    bool isAllCorrect = true;
+    benchTree tree;
+    parallelLevelBench parallel(options.threadNum);
+    printHeader(options.format);
+    for(TREE_SHAPE shape : options.shapes){
+        for(std::size_t nodeNum : options.sizes){
+            tree.build(shape, nodeNum, options.seed);
+            for(const benchOperation& op : operations){
+                if(!options.filter.empty() && std::string(op.name).find(options.filter) == std::string::npos)
+                    continue;
+                if(op.kind == SCAN_STATISTICS && op.method > detectSimdLevel())
+                    continue;
+                benchResult result;
+                if(!measure(tree, op, options, parallel, result)){
+                    std::fprintf(stderr, "wrong result: %s on %s tree of %zu nodes\n", op.name, shapeName(shape), nodeNum);
+                    isAllCorrect = false;
+                }
+                printResult(options.format, shape, nodeNum, op, result);
+                if(options.isLevelProfiled && op.mode == binaryTree::LEVELORDER_TRAVERSAL)
+                    printLevels(options.format, shape, nodeNum, op, profileLevels(tree.getTree(), op, parallel));
+            }
+        }
+    }
+    return isAllCorrect ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+#include "arraytree.h"
+
+const arrayTree::index_type arrayTree::nil;
+const std::size_t arrayTree::maxNodeNum;
+
+arrayTree::arrayTree():
+    algorithm(arrayTreeAccess(this))
+{
+}
+
+/**
+ * @brief arrayTree::reserve 预留结点空间，批量建树时避免反复扩容
+ * @param n 预计的结点数
+ */
+void arrayTree::reserve(std::size_t n)
+{
+    leftChild.reserve(n);
+    rightChild.reserve(n);
+    parentNode.reserve(n);
+    leftTag.reserve((n + 63) / 64);
+    rightTag.reserve((n + 63) / 64);
+}
+
+/**
+ * @brief arrayTree::addNode 新增一个没有孩子的结点
+ * @return 新结点的下标，结点数已达maxNodeNum时为nil
+ */
+arrayTree::index_type arrayTree::addNode()
+{
+    if(isFull())
+        return nil;
+    index_type n = index_type(leftChild.size());
+    leftChild.push_back(nil);
+    rightChild.push_back(nil);
+    parentNode.push_back(nil);
+    if((n & 63) == 0){
+        leftTag.push_back(0);
+        rightTag.push_back(0);
+    }
+    if(root == nil)
+        root = n;
+    return n;
+}
+
+/**
+ * @brief arrayTree::addChild 为parent新增一个左/右孩子
+ * @param parent 双亲结点
+ * @param isLeftChild 是否为左孩子
+ * @return 新结点的下标，结点数已达maxNodeNum时为nil
+ */
+arrayTree::index_type arrayTree::addChild(index_type parent, bool isLeftChild)
+{
+    index_type n = addNode();
+    if(n == nil)
+        return nil;
+    if(isLeftChild)
+        setLeftChild(parent, n, binaryTreeNode::LINK);
+    else
+        setRightChild(parent, n, binaryTreeNode::LINK);
+    setParentNode(n, parent);
+    return n;
+}
+
+/**
+ * @brief arrayTree::clear 清空所有结点（保留已分配的空间）
+ */
+void arrayTree::clear()
+{
+    leftChild.clear();
+    rightChild.clear();
+    parentNode.clear();
+    leftTag.clear();
+    rightTag.clear();
+    root = nil;
+}
+
+std::size_t arrayTree::size() const
+{
+    return leftChild.size();
+}
+
+arrayTree::index_type arrayTree::getRoot() const
+{
+    return root;
+}
+
+void arrayTree::setRoot(index_type _root)
+{
+    root = _root;
+}
+
+/**
+ * @brief arrayTree::countLeafNode 统计叶子结点数
+ * @return 二叉树的叶子结点数
+ */
+std::size_t arrayTree::countLeafNode()
+{
+    return algorithm.countLeafNode(root);
+}
+
+/**
+ * @brief arrayTree::scanStatistics 顺序扫描孩子数组与标记位图求统计信息
+ * @param level 使用的指令集
+ * @return 全部结点的统计信息
+ */
+treeStatistics arrayTree::scanStatistics(SIMD_LEVEL level) const
+{
+    return scanTreeStatistics(leftChild.data(), rightChild.data(), leftTag.data(), rightTag.data(), size(), level);
+}
+
+/**
+ * @brief arrayTree::clearThreadedTree 清除线索
+ */
+void arrayTree::clearThreadedTree()
+{
+    algorithm.clearThreadedTree(root);
+}
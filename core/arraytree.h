@@ -0,0 +1,158 @@
+#ifndef ARRAYTREE_H
+#define ARRAYTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "binarytreenode.h"
+#include "traversal.h"
+#include "treeiterator.h"
+#include "treestatistics.h"
+
+// 以数组存储的二叉树
+class arrayTree;
+
+// arrayTree的结点访问策略（结点即下标）
+struct arrayTreeAccess
+{
+    typedef std::uint32_t node_type;
+
+    arrayTree* tree;
+
+    explicit arrayTreeAccess(arrayTree* _tree = nullptr): tree(_tree) {}
+
+    node_type null() const;
+    node_type left(node_type n) const;
+    node_type right(node_type n) const;
+    binaryTreeNode::TAG leftTag(node_type n) const;
+    binaryTreeNode::TAG rightTag(node_type n) const;
+    node_type leftAndTag(node_type n, binaryTreeNode::TAG& tag) const;
+    node_type rightAndTag(node_type n, binaryTreeNode::TAG& tag) const;
+    node_type parent(node_type n) const;
+    void setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const;
+    void setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const;
+};
+
+
+/*
+ * 紧凑的结构数组（SoA）二叉树存储
+ * 左右孩子与双亲为连续数组中的32位下标，LINK/THREAD标记压缩在位图中，
+ * 每个结点约12.25字节，千万级结点仅需数百MB，遍历时对缓存友好
+ * 与binaryTree共用traversal.h中的遍历与线索化算法
+ */
+class arrayTree
+{
+public:
+    typedef std::uint32_t index_type;
+    static const index_type nil = 0xFFFFFFFFu;     // 空结点
+    static const std::size_t maxNodeNum = nil;      // 下标0 ~ nil-1，再多则与nil重合
+
+
+    arrayTree();
+    arrayTree(const arrayTree&) = delete;
+    arrayTree& operator=(const arrayTree&) = delete;
+
+    // 结点管理
+    void reserve(std::size_t n);
+    index_type addNode();       // 结点数已达maxNodeNum时不新增，返回nil
+    index_type addChild(index_type parent, bool isLeftChild);
+    void clear();
+    std::size_t size() const;
+    bool isFull() const { return size() >= maxNodeNum; }
+    index_type getRoot() const;
+    void setRoot(index_type _root);
+
+    // 结点信息
+    index_type getLeftChild(index_type n) const { return leftChild[n]; }
+    index_type getRightChild(index_type n) const { return rightChild[n]; }
+    binaryTreeNode::TAG getLeftChildTag(index_type n) const { return testBit(leftTag, n) ? binaryTreeNode::THREAD : binaryTreeNode::LINK; }
+    binaryTreeNode::TAG getRightChildTag(index_type n) const { return testBit(rightTag, n) ? binaryTreeNode::THREAD : binaryTreeNode::LINK; }
+    index_type getParentNode(index_type n) const { return parentNode[n]; }
+    void setLeftChild(index_type n, index_type c, binaryTreeNode::TAG tag) { leftChild[n] = c; assignBit(leftTag, n, tag == binaryTreeNode::THREAD); }
+    void setRightChild(index_type n, index_type c, binaryTreeNode::TAG tag) { rightChild[n] = c; assignBit(rightTag, n, tag == binaryTreeNode::THREAD); }
+    void setParentNode(index_type n, index_type p) { parentNode[n] = p; }
+
+    // 统计叶子结点数
+    std::size_t countLeafNode();
+
+    // 顺序扫描数组求叶子数、线索数与空孩子数（向量化，不沿树遍历）
+    treeStatistics scanStatistics(SIMD_LEVEL level = detectSimdLevel()) const;
+
+    // 遍历（visit接收结点下标）
+    template<class Order, class Visitor>
+    void traversal(Visitor&& visit)
+    {
+        algorithm.traversal<Order>(root, visit);
+    }
+
+    template<class Order, class Visitor>
+    void traversal_Thr(Visitor&& visit)
+    {
+        algorithm.traversal_Thr<Order>(root, visit);
+    }
+
+    template<class Order, class Visitor>
+    void traversal_Morris(Visitor&& visit)
+    {
+        algorithm.traversal_Morris<Order>(root, visit);
+    }
+
+    // 线索化
+    template<class Order, class Visitor>
+    void createThreadedTree(Visitor&& visit)
+    {
+        algorithm.createThreadedTree<Order>(root, visit);
+    }
+
+    void clearThreadedTree();
+
+    // 惰性遍历区间（元素为结点下标）
+    template<class Order>
+    traversalRange<traversalIterator<Order, arrayTreeAccess> > range()
+    {
+        typedef traversalIterator<Order, arrayTreeAccess> iterator;
+        return traversalRange<iterator>(iterator(arrayTreeAccess(this), root), iterator(arrayTreeAccess(this)));
+    }
+
+    template<class Order>
+    traversalRange<threadedIterator<Order, arrayTreeAccess> > threadedRange()
+    {
+        typedef threadedIterator<Order, arrayTreeAccess> iterator;
+        return traversalRange<iterator>(iterator(arrayTreeAccess(this), root), iterator(arrayTreeAccess(this)));
+    }
+
+private:
+    std::vector<index_type> leftChild, rightChild;
+    std::vector<index_type> parentNode;             // 双亲（供后序线索遍历求后继）
+    std::vector<std::uint64_t> leftTag, rightTag;  // 置位表示THREAD
+    index_type root = nil;
+    treeTraversal<arrayTreeAccess> algorithm;
+
+    static bool testBit(const std::vector<std::uint64_t>& bits, index_type n)
+    {
+        return (bits[n >> 6] >> (n & 63)) & 1u;
+    }
+
+    static void assignBit(std::vector<std::uint64_t>& bits, index_type n, bool value)
+    {
+        std::uint64_t mask = std::uint64_t(1) << (n & 63);
+        if(value)
+            bits[n >> 6] |= mask;
+        else
+            bits[n >> 6] &= ~mask;
+    }
+};
+
+
+inline arrayTreeAccess::node_type arrayTreeAccess::null() const { return arrayTree::nil; }
+inline arrayTreeAccess::node_type arrayTreeAccess::left(node_type n) const { return tree->getLeftChild(n); }
+inline arrayTreeAccess::node_type arrayTreeAccess::right(node_type n) const { return tree->getRightChild(n); }
+inline binaryTreeNode::TAG arrayTreeAccess::leftTag(node_type n) const { return tree->getLeftChildTag(n); }
+inline binaryTreeNode::TAG arrayTreeAccess::rightTag(node_type n) const { return tree->getRightChildTag(n); }
+inline arrayTreeAccess::node_type arrayTreeAccess::leftAndTag(node_type n, binaryTreeNode::TAG& tag) const { tag = leftTag(n); return left(n); }
+inline arrayTreeAccess::node_type arrayTreeAccess::rightAndTag(node_type n, binaryTreeNode::TAG& tag) const { tag = rightTag(n); return right(n); }
+inline arrayTreeAccess::node_type arrayTreeAccess::parent(node_type n) const { return tree->getParentNode(n); }
+inline void arrayTreeAccess::setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const { tree->setLeftChild(n, c, tag); }
+inline void arrayTreeAccess::setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const { tree->setRightChild(n, c, tag); }
+
+#endif // ARRAYTREE_H
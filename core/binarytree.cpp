@@ -0,0 +1,329 @@
+#include "binarytree.h"
+
+binaryTreeNode::~binaryTreeNode()
+{
+}
+
+// 沿LINK的孩子（线索视为空）
+static inline binaryTreeNode* linkedLeftChild(const binaryTreeNode* cur)
+{
+    return cur->getLeftChildTag() == binaryTreeNode::LINK ? cur->getLeftChild() : nullptr;
+}
+
+static inline binaryTreeNode* linkedRightChild(const binaryTreeNode* cur)
+{
+    return cur->getRightChildTag() == binaryTreeNode::LINK ? cur->getRightChild() : nullptr;
+}
+
+// 子树高度，空树为0
+static inline std::size_t subtreeHeightOf(const binaryTreeNode* cur)
+{
+    return cur ? cur->getSubtreeHeight() : 0;
+}
+
+/**
+ * @brief binaryTree::binaryTree 传入对应的根节点指针构造二叉树
+ * @param _root 根节点指针
+ */
+binaryTree::binaryTree(binaryTreeNode* _root):
+    root(_root)
+{
+}
+
+binaryTreeNode* binaryTree::getRoot() const
+{
+    return root;
+}
+
+void binaryTree::setRoot(binaryTreeNode* _root)
+{
+    root = _root;
+}
+
+/**
+ * @brief binaryTree::insertChild 插入孩子结点，并沿双亲链增量更新各祖先的统计信息
+ * @param parent 双亲结点
+ * @param child 新的孩子（可以带有子树）
+ * @param isLeftChild 是否为左孩子
+ */
+void binaryTree::insertChild(binaryTreeNode* parent, binaryTreeNode* child, bool isLeftChild)
+{
+    bool wasLeaf = !linkedLeftChild(parent) && !linkedRightChild(parent);
+
+    if(isLeftChild)
+        parent->setLeftChild(child, binaryTreeNode::LINK);
+    else
+        parent->setRightChild(child, binaryTreeNode::LINK);
+    child->setParentNode(parent);
+
+    // 双亲原本是叶子时，它不再计入叶子数
+    std::size_t addedLeafNum = child->subtreeLeafNum - (wasLeaf ? 1 : 0);
+    bool heightChanged = true;
+
+    for(binaryTreeNode* p = parent; p; p = p->getParentNode()){
+        p->subtreeSize += child->subtreeSize;
+        p->subtreeLeafNum += addedLeafNum;
+        if(heightChanged){
+            std::size_t leftHeight = subtreeHeightOf(linkedLeftChild(p));
+            std::size_t rightHeight = subtreeHeightOf(linkedRightChild(p));
+            std::size_t height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+            heightChanged = (height != p->subtreeHeight);
+            p->subtreeHeight = height;
+        }
+    }
+}
+
+/**
+ * @brief binaryTree::getNodeNum
+ * @return 二叉树的结点数
+ */
+std::size_t binaryTree::getNodeNum() const
+{
+    return root ? root->subtreeSize : 0;
+}
+
+/**
+ * @brief binaryTree::getHeight
+ * @return 二叉树的高度
+ */
+std::size_t binaryTree::getHeight() const
+{
+    return root ? root->subtreeHeight : 0;
+}
+
+/**
+ * @brief binaryTree::getLeafNodeNum 增量维护的叶子结点数，无需遍历
+ * @return 二叉树的叶子结点数
+ */
+std::size_t binaryTree::getLeafNodeNum() const
+{
+    return root ? root->subtreeLeafNum : 0;
+}
+
+/**
+ * @brief binaryTree::reserveScratch 预留遍历的暂存区，之后的遍历不再分配内存
+ * @param height 树高（栈式遍历）
+ * @param width 最宽一层的上界（层序遍历），见levelWidthBound
+ */
+void binaryTree::reserveScratch(std::size_t height, std::size_t width)
+{
+    scratch.reserve(height);
+    scratch.reserveQueue(width);
+}
+
+/**
+ * @brief binaryTree::countLeafNode 供外部调用，完整遍历统计叶子结点数
+ * @return 二叉树的叶子结点数
+ */
+std::size_t binaryTree::countLeafNode()
+{
+    if(isMetricsEnabled){
+        scopedPhaseTimer timer(metrics, traversalMetrics::COUNT_LEAF_PHASE);
+        return countedAlgorithm.countLeafNode(root);
+    }
+    return algorithm.countLeafNode(root);
+}
+
+/**
+ * @brief binaryTree::setMetricsEnabled 开启/关闭遍历的统计
+ * @param enabled 是否统计（关闭时不产生任何额外开销）
+ */
+void binaryTree::setMetricsEnabled(bool enabled)
+{
+    isMetricsEnabled = enabled;
+}
+
+bool binaryTree::getMetricsEnabled() const
+{
+    return isMetricsEnabled;
+}
+
+/**
+ * @brief binaryTree::resetMetrics 清零计数与各阶段耗时
+ */
+void binaryTree::resetMetrics()
+{
+    countedAlgorithm.getStats().reset();
+    metrics = traversalMetrics();
+}
+
+/**
+ * @brief binaryTree::getMetrics
+ * @return 上次resetMetrics()以来的统计信息
+ */
+traversalMetrics binaryTree::getMetrics() const
+{
+    traversalMetrics result = metrics;
+    result.counters = countedAlgorithm.getStats();
+    return result;
+}
+
+/**
+ * @brief binaryTree::preOrderTraversal
+ */
+void binaryTree::preOrderTraversal()
+{
+    traversal<preOrder>();
+}
+
+/**
+ * @brief binaryTree::inOrderTraversal
+ */
+void binaryTree::inOrderTraversal()
+{
+    traversal<inOrder>();
+}
+
+/**
+ * @brief binaryTree::postOrderTraversal
+ */
+void binaryTree::postOrderTraversal()
+{
+    traversal<postOrder>();
+}
+
+/**
+ * @brief binaryTree::preOrderTraversal_Thr 线索化遍历前序二叉树
+ */
+void binaryTree::preOrderTraversal_Thr()
+{
+    traversal_Thr<preOrder>();
+}
+
+/**
+ * @brief binaryTree::inOrderTraversal_Thr 线索化遍历中序二叉树
+ */
+void binaryTree::inOrderTraversal_Thr()
+{
+    traversal_Thr<inOrder>();
+}
+
+/**
+ * @brief binaryTree::postOrderTraversal_Thr 线索化遍历后序二叉树（借助双亲指针）
+ */
+void binaryTree::postOrderTraversal_Thr()
+{
+    traversal_Thr<postOrder>();
+}
+
+/**
+ * @brief binaryTree::preOrderTraversal_Morris Morris前序遍历（O(1)额外空间）
+ */
+void binaryTree::preOrderTraversal_Morris()
+{
+    traversal_Morris<preOrder>();
+}
+
+/**
+ * @brief binaryTree::inOrderTraversal_Morris Morris中序遍历（O(1)额外空间）
+ */
+void binaryTree::inOrderTraversal_Morris()
+{
+    traversal_Morris<inOrder>();
+}
+
+/**
+ * @brief binaryTree::postOrderTraversal_Morris Morris后序遍历（O(1)额外空间）
+ */
+void binaryTree::postOrderTraversal_Morris()
+{
+    traversal_Morris<postOrder>();
+}
+
+/**
+ * @brief binaryTree::levelOrderTraversal 层序遍历（环形队列），统计开启时记录各层耗时
+ */
+void binaryTree::levelOrderTraversal()
+{
+    typedef std::chrono::steady_clock clock;
+    auto visitor = [this](binaryTreeNode* p){ visit(p); };
+    reserveScratch(getHeight(), levelWidthBound(getHeight(), getLeafNodeNum()));
+    if(isMetricsEnabled){
+        scopedPhaseTimer timer(metrics, traversalMetrics::TRAVERSAL_PHASE);
+        clock::time_point last = clock::now();
+        countedAlgorithm.levelTraversal(root, visitor, [this, &last](std::size_t depth, std::size_t width){
+            clock::time_point now = clock::now();
+            metrics.addLevel(depth, width, std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count()));
+            last = now;
+        }, scratch);
+    }
+    else
+        algorithm.traversal<levelOrder>(root, visitor, scratch);
+}
+
+/**
+ * @brief binaryTree::traverse 按运行时选择的顺序与方法遍历
+ * @param mode 前/中/后序
+ * @param method 栈/线索/Morris
+ */
+void binaryTree::traverse(int mode, int method)
+{
+    if(mode == LEVELORDER_TRAVERSAL){
+        levelOrderTraversal();
+        return;
+    }
+    switch(method){
+        case STACK_TRAVERSAL:
+            switch(mode){
+                case PREORDER_TRAVERSAL: traversal<preOrder>(); break;
+                case INORDER_TRAVERSAL: traversal<inOrder>(); break;
+                case POSTORDER_TRAVERSAL: traversal<postOrder>(); break;
+            }
+            break;
+        case THREADED_TRAVERSAL:
+            switch(mode){
+                case PREORDER_TRAVERSAL: traversal_Thr<preOrder>(); break;
+                case INORDER_TRAVERSAL: traversal_Thr<inOrder>(); break;
+                case POSTORDER_TRAVERSAL: traversal_Thr<postOrder>(); break;
+            }
+            break;
+        case MORRIS_TRAVERSAL:
+            switch(mode){
+                case PREORDER_TRAVERSAL: traversal_Morris<preOrder>(); break;
+                case INORDER_TRAVERSAL: traversal_Morris<inOrder>(); break;
+                case POSTORDER_TRAVERSAL: traversal_Morris<postOrder>(); break;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief binaryTree::createThreadedTree 供外部调用，按运行时的mode分派到编译期特化的线索化
+ * @param mode 前/中/后续
+ */
+void binaryTree::createThreadedTree(int mode)
+{
+    switch(mode){
+        case PREORDER_TRAVERSAL:
+            createThreadedTree<preOrder>();
+            break;
+        case INORDER_TRAVERSAL:
+            createThreadedTree<inOrder>();
+            break;
+        case POSTORDER_TRAVERSAL:
+            createThreadedTree<postOrder>();
+            break;
+    }
+}
+
+/**
+ * @brief binaryTree::clearThreadedTree 供外部调用，清除线索
+ */
+void binaryTree::clearThreadedTree()
+{
+    if(isMetricsEnabled){
+        scopedPhaseTimer timer(metrics, traversalMetrics::CLEAR_THREAD_PHASE);
+        countedAlgorithm.clearThreadedTree(root);
+    }
+    else
+        algorithm.clearThreadedTree(root);
+}
+
+/**
+ * @brief binaryTree::visit 访问结点
+ * @param cur 当前访问的结点
+ */
+void binaryTree::visit(binaryTreeNode* cur)
+{
+    cur->visit();
+}
@@ -0,0 +1,146 @@
+#ifndef BINARYTREE_H
+#define BINARYTREE_H
+
+#include <cstddef>
+#include "binarytreenode.h"
+#include "traversal.h"
+#include "treeiterator.h"
+#include "traversalmetrics.h"
+
+// 二叉树类（不依赖Qt，可脱离界面单独链接使用）
+// 通过虚函数访问结点，是对traversal.h中模板算法的一层薄封装
+class binaryTree
+{
+    binaryTreeNode* root = nullptr;      // 二叉树的根节点
+    treeTraversal<virtualNodeAccess> algorithm;
+    traversalArena<binaryTreeNode*> scratch;     // 栈式遍历的暂存区，遍历前按树高预留
+
+    // 统计：开启时改用带计数的算法实例，关闭时的遍历与未统计前完全相同
+    bool isMetricsEnabled = false;
+    treeTraversal<virtualNodeAccess, traversalCounters> countedAlgorithm;
+    traversalMetrics metrics;
+
+public:
+    // 遍历方式：前/中/后序与层序
+    enum TRAVERSAL_MODE { PREORDER_TRAVERSAL, INORDER_TRAVERSAL, POSTORDER_TRAVERSAL, LEVELORDER_TRAVERSAL };
+    // 遍历的实现方法：栈 / 线索（需先线索化）/ Morris（需未线索化）
+    // 层序遍历只有队列一种实现，不论method均用环形队列
+    enum TRAVERSAL_METHOD { STACK_TRAVERSAL, THREADED_TRAVERSAL, MORRIS_TRAVERSAL };
+
+    binaryTree(binaryTreeNode* _root = nullptr);
+
+    binaryTreeNode* getRoot() const;
+    // 更换根结点（为空即清空），不释放原有结点
+    void setRoot(binaryTreeNode* _root);
+
+    // 插入孩子，沿双亲链增量更新统计信息（O(深度)）
+    void insertChild(binaryTreeNode* parent, binaryTreeNode* child, bool isLeftChild);
+
+    // 增量维护的统计信息，O(1)
+    std::size_t getNodeNum() const;
+    std::size_t getHeight() const;
+    std::size_t getLeafNodeNum() const;
+
+    // 为高为height的树预留栈式遍历的暂存区（结点的统计信息无效时由调用方给出树高）
+    void reserveScratch(std::size_t height, std::size_t width = 0);
+
+    // 完整遍历统计叶子结点数
+    std::size_t countLeafNode();
+
+    // 遍历的统计信息（计数与各阶段耗时在多次调用间累加）
+    void setMetricsEnabled(bool enabled);
+    bool getMetricsEnabled() const;
+    void resetMetrics();
+    traversalMetrics getMetrics() const;
+
+    // 遍历
+    void preOrderTraversal();
+    void inOrderTraversal();
+    void postOrderTraversal();
+    void preOrderTraversal_Thr();
+    void inOrderTraversal_Thr();
+    void postOrderTraversal_Thr();
+    void preOrderTraversal_Morris();
+    void inOrderTraversal_Morris();
+    void postOrderTraversal_Morris();
+    void levelOrderTraversal();
+
+    // 按运行时选择的顺序与方法遍历
+    void traverse(int mode, int method);
+
+    // 线索化（层序没有对应的线索化，mode为层序时不做任何事）
+    void createThreadedTree(int mode);
+    void clearThreadedTree();
+
+    // 编译期指定遍历顺序（Order为preOrder/inOrder/postOrder）
+    template<class Order>
+    void traversal()
+    {
+        auto visitor = [this](binaryTreeNode* p){ visit(p); };
+        reserveScratch(getHeight());
+        if(isMetricsEnabled){
+            scopedPhaseTimer timer(metrics, traversalMetrics::TRAVERSAL_PHASE);
+            countedAlgorithm.traversal<Order>(root, visitor, scratch);
+        }
+        else
+            algorithm.traversal<Order>(root, visitor, scratch);
+    }
+
+    template<class Order>
+    void traversal_Thr()
+    {
+        auto visitor = [this](binaryTreeNode* p){ visit(p); };
+        if(isMetricsEnabled){
+            scopedPhaseTimer timer(metrics, traversalMetrics::TRAVERSAL_PHASE);
+            countedAlgorithm.traversal_Thr<Order>(root, visitor);
+        }
+        else
+            algorithm.traversal_Thr<Order>(root, visitor);
+    }
+
+    template<class Order>
+    void traversal_Morris()
+    {
+        auto visitor = [this](binaryTreeNode* p){ visit(p); };
+        if(isMetricsEnabled){
+            scopedPhaseTimer timer(metrics, traversalMetrics::TRAVERSAL_PHASE);
+            countedAlgorithm.traversal_Morris<Order>(root, visitor);
+        }
+        else
+            algorithm.traversal_Morris<Order>(root, visitor);
+    }
+
+    template<class Order>
+    void createThreadedTree()
+    {
+        auto visitor = [this](binaryTreeNode* p){ visit(p); };
+        if(isMetricsEnabled){
+            scopedPhaseTimer timer(metrics, traversalMetrics::THREADING_PHASE);
+            countedAlgorithm.createThreadedTree<Order>(root, visitor);
+        }
+        else
+            algorithm.createThreadedTree<Order>(root, visitor);
+    }
+
+    // 惰性遍历区间（Order还可为levelOrder），例如 for(binaryTreeNode* p : tree.range<inOrder>())
+    template<class Order>
+    traversalRange<traversalIterator<Order, virtualNodeAccess> > range() const
+    {
+        typedef traversalIterator<Order, virtualNodeAccess> iterator;
+        return traversalRange<iterator>(iterator(virtualNodeAccess(), root), iterator());
+    }
+
+    // 沿线索求后继的惰性遍历区间，要求已按Order线索化
+    template<class Order>
+    traversalRange<threadedIterator<Order, virtualNodeAccess> > threadedRange() const
+    {
+        typedef threadedIterator<Order, virtualNodeAccess> iterator;
+        return traversalRange<iterator>(iterator(virtualNodeAccess(), root), iterator());
+    }
+
+private:
+    // 访问某结点
+    void visit(binaryTreeNode* cur);
+};
+
+#endif // BINARYTREE_H
@@ -0,0 +1,45 @@
+#ifndef BINARYTREENODE_H
+#define BINARYTREENODE_H
+
+#include <cstddef>
+
+// 二叉树的类
+class binaryTree;
+
+// 二叉树的结点类（抽象类）
+class binaryTreeNode
+{
+    friend class binaryTree;
+
+public:
+    enum TAG { LINK, THREAD };
+    virtual binaryTreeNode* getLeftChild() const = 0 ;
+    virtual binaryTreeNode* getRightChild() const = 0 ;
+    virtual enum TAG getLeftChildTag() const = 0 ;
+    virtual enum TAG getRightChildTag() const = 0 ;
+    virtual binaryTreeNode* getParentNode() const = 0 ;
+    // 一次调用同时取得孩子与标记（线索遍历的每一步都需要二者），孩子与标记存放在一起的结点应当重写
+    virtual binaryTreeNode* getLeftLink(enum TAG& tag) const { tag = getLeftChildTag(); return getLeftChild(); }
+    virtual binaryTreeNode* getRightLink(enum TAG& tag) const { tag = getRightChildTag(); return getRightChild(); }
+    virtual void setLeftChild(binaryTreeNode* leftChild, enum binaryTreeNode::TAG tag) = 0;
+    virtual void setRightChild(binaryTreeNode* rightChild, enum binaryTreeNode::TAG tag) = 0;
+    virtual void setParentNode(binaryTreeNode* parentNode) = 0;
+    virtual void visit() = 0;
+    virtual ~binaryTreeNode() = 0;
+
+    // 以该结点为根的子树的统计信息（由binaryTree::insertChild增量维护）
+    std::size_t getSubtreeSize() const { return subtreeSize; }
+    std::size_t getSubtreeHeight() const { return subtreeHeight; }
+    std::size_t getSubtreeLeafNum() const { return subtreeLeafNum; }
+
+protected:
+    // 结点被复用时恢复为单个结点的统计信息
+    void resetSubtreeStatistics() { subtreeSize = subtreeHeight = subtreeLeafNum = 1; }
+
+private:
+    std::size_t subtreeSize = 1;        // 结点数
+    std::size_t subtreeHeight = 1;      // 高度
+    std::size_t subtreeLeafNum = 1;     // 叶子结点数
+};
+
+#endif // BINARYTREENODE_H
@@ -0,0 +1,32 @@
+# 二叉树核心算法（不依赖Qt），供界面程序与静态库共同引用
+
+CONFIG += thread
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += \
+    $$PWD/binarytree.cpp \
+    $$PWD/arraytree.cpp \
+    $$PWD/threadpool.cpp \
+    $$PWD/treeparser.cpp \
+    $$PWD/treesnapshot.cpp \
+    $$PWD/traversalmetrics.cpp \
+    $$PWD/traversaltrace.cpp \
+    $$PWD/treestatistics.cpp
+
+HEADERS += \
+    $$PWD/binarytreenode.h \
+    $$PWD/traversal.h \
+    $$PWD/traversalmetrics.h \
+    $$PWD/traversaltrace.h \
+    $$PWD/treeiterator.h \
+    $$PWD/binarytree.h \
+    $$PWD/arraytree.h \
+    $$PWD/threadpool.h \
+    $$PWD/parallelreduce.h \
+    $$PWD/treeparser.h \
+    $$PWD/treesnapshot.h \
+    $$PWD/treestatistics.h \
+    $$PWD/taggednode.h \
+    $$PWD/tidylayout.h
@@ -0,0 +1,14 @@
+#-------------------------------------------------
+#
+# 二叉树遍历核心静态库（不依赖Qt）
+# 可单独用 qmake 构建，供非界面程序链接
+#
+#-------------------------------------------------
+
+TEMPLATE = lib
+TARGET = bintreecore
+
+CONFIG += staticlib c++11
+CONFIG -= qt
+
+include(core.pri)
@@ -0,0 +1,339 @@
+#ifndef PARALLELREDUCE_H
+#define PARALLELREDUCE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "binarytreenode.h"
+#include "threadpool.h"
+
+/*
+ * 以子树为单位切分的并行归约
+ * 每个工作线程顺序处理自己的子树，遇到分叉且自己的任务队列为空时，把右子树作为任务发布出去；
+ * 空闲的线程从其他线程的队列头部窃取（较大的）子树。规模小于sequentialCutoff的树直接顺序计算。
+ * combine须满足结合律与交换律（如求和、最小、最大）。
+ */
+template<class Access>
+class parallelReducer
+{
+public:
+    typedef typename Access::node_type node_type;
+
+    parallelReducer(threadPool& _pool, const Access& _access = Access()):
+        pool(_pool),
+        access(_access)
+    {
+    }
+
+    // 小于该结点数（已知时）的树直接顺序计算
+    void setSequentialCutoff(std::size_t cutoff) { sequentialCutoff = cutoff; }
+    // 每个线程至少顺序处理grain个结点后才再次发布任务，避免任务过细
+    void setGrainSize(std::size_t grain) { grainSize = grain; }
+
+    /**
+     * @brief reduce 通用归约：对每个结点求map(node, depth)，再用combine合并
+     * @param root 根结点
+     * @param identity combine的单位元
+     * @param map 结点到值的映射，depth为结点深度（根为0）
+     * @param combine 满足结合律、交换律的合并操作
+     * @param sizeHint 树的结点数（未知时为0）
+     */
+    template<class T, class Map, class Combine>
+    T reduce(node_type root, T identity, Map map, Combine combine, std::size_t sizeHint = 0)
+    {
+        if(root == access.null())
+            return identity;
+        if((sizeHint && sizeHint < sequentialCutoff) || pool.size() == 1)
+            return reduceSequential(root, identity, map, combine);
+
+        unsigned workerNum = pool.size();
+        std::unique_ptr<worker[]> workers(new worker[workerNum]);
+        std::vector<T> results(workerNum, identity);
+        std::atomic<std::size_t> pending(1);
+
+        workers[0].tasks.push_back(task{root, 0});
+        workers[0].taskNum = 1;
+
+        pool.run([&](unsigned id){
+            T acc = identity;
+            std::vector<task> stack;
+            task t;
+            while(pending.load(std::memory_order_acquire) > 0){
+                if(popLocal(workers.get(), id, t) || steal(workers.get(), workerNum, id, t)){
+                    process(workers.get(), id, t, stack, acc, map, combine, pending);
+                    pending.fetch_sub(1, std::memory_order_acq_rel);
+                }
+                else
+                    std::this_thread::yield();
+            }
+            results[id] = acc;
+        });
+
+        T result = identity;
+        for(const T& r : results)
+            result = combine(result, r);
+        return result;
+    }
+
+    // 常用的统计
+    std::size_t countLeafNode(node_type root, std::size_t sizeHint = 0)
+    {
+        return reduce(root, std::size_t(0),
+                      [this](node_type n, std::size_t){ return std::size_t(linkedLeft(n) == access.null() && linkedRight(n) == access.null()); },
+                      [](std::size_t a, std::size_t b){ return a + b; }, sizeHint);
+    }
+
+    std::size_t countNode(node_type root, std::size_t sizeHint = 0)
+    {
+        return reduce(root, std::size_t(0),
+                      [](node_type, std::size_t){ return std::size_t(1); },
+                      [](std::size_t a, std::size_t b){ return a + b; }, sizeHint);
+    }
+
+    std::size_t height(node_type root, std::size_t sizeHint = 0)
+    {
+        return reduce(root, std::size_t(0),
+                      [](node_type, std::size_t depth){ return depth + 1; },
+                      [](std::size_t a, std::size_t b){ return std::max(a, b); }, sizeHint);
+    }
+
+private:
+    struct task
+    {
+        node_type node;
+        std::size_t depth;
+    };
+
+    // 每个工作线程的任务队列：自己从尾部取，其他线程从头部窃取
+    struct worker
+    {
+        std::mutex mutex;
+        std::deque<task> tasks;
+        std::atomic<std::size_t> taskNum{0};
+        char padding[64];       // 避免相邻工作线程的计数共享缓存行
+    };
+
+    threadPool& pool;
+    Access access;
+    std::size_t sequentialCutoff = 1 << 14;
+    std::size_t grainSize = 1 << 10;
+
+    node_type linkedLeft(node_type n) const { return access.leftTag(n) == binaryTreeNode::LINK ? access.left(n) : access.null(); }
+    node_type linkedRight(node_type n) const { return access.rightTag(n) == binaryTreeNode::LINK ? access.right(n) : access.null(); }
+
+    static bool popLocal(worker* workers, unsigned id, task& t)
+    {
+        worker& w = workers[id];
+        if(w.taskNum.load(std::memory_order_relaxed) == 0)
+            return false;
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if(w.tasks.empty())
+            return false;
+        t = w.tasks.back();
+        w.tasks.pop_back();
+        w.taskNum.store(w.tasks.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    static bool steal(worker* workers, unsigned workerNum, unsigned id, task& t)
+    {
+        for(unsigned k = 1; k < workerNum; ++k){
+            worker& victim = workers[(id + k) % workerNum];
+            if(victim.taskNum.load(std::memory_order_relaxed) == 0)
+                continue;
+            std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+            if(!lock.owns_lock() || victim.tasks.empty())
+                continue;
+            t = victim.tasks.front();
+            victim.tasks.pop_front();
+            victim.taskNum.store(victim.tasks.size(), std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // 顺序处理一棵子树，必要时把右子树发布为可窃取的任务
+    template<class T, class Map, class Combine>
+    void process(worker* workers, unsigned id, task root, std::vector<task>& stack, T& acc,
+                 Map& map, Combine& combine, std::atomic<std::size_t>& pending)
+    {
+        worker& self = workers[id];
+        std::size_t sinceSplit = 0;
+
+        stack.clear();
+        stack.push_back(root);
+        while(!stack.empty()){
+            task t = stack.back();
+            stack.pop_back();
+            acc = combine(acc, map(t.node, t.depth));
+            ++sinceSplit;
+
+            node_type l = linkedLeft(t.node), r = linkedRight(t.node);
+            if(r != access.null()){
+                task rt{r, t.depth + 1};
+                if(l != access.null() && sinceSplit >= grainSize && self.taskNum.load(std::memory_order_relaxed) == 0){
+                    pending.fetch_add(1, std::memory_order_acq_rel);
+                    std::lock_guard<std::mutex> lock(self.mutex);
+                    self.tasks.push_back(rt);
+                    self.taskNum.store(self.tasks.size(), std::memory_order_relaxed);
+                    sinceSplit = 0;
+                }
+                else
+                    stack.push_back(rt);
+            }
+            if(l != access.null())
+                stack.push_back(task{l, t.depth + 1});
+        }
+    }
+
+    template<class T, class Map, class Combine>
+    T reduceSequential(node_type root, T acc, Map& map, Combine& combine)
+    {
+        std::vector<task> stack;
+        stack.push_back(task{root, 0});
+        while(!stack.empty()){
+            task t = stack.back();
+            stack.pop_back();
+            acc = combine(acc, map(t.node, t.depth));
+            node_type l = linkedLeft(t.node), r = linkedRight(t.node);
+            if(r != access.null())
+                stack.push_back(task{r, t.depth + 1});
+            if(l != access.null())
+                stack.push_back(task{l, t.depth + 1});
+        }
+        return acc;
+    }
+};
+
+
+/*
+ * 按层并行的层序遍历
+ * 每一层（frontier）按下标均分给各工作线程，各线程访问自己的一段并把孩子依次写入自己的缓冲区，
+ * 再按线程顺序拼接为下一层，因此各层内的结点仍保持从左到右的顺序。
+ * 同一层内的结点被并发访问，visit(node, workerId)须可并发调用（可按workerId分别累计）。
+ * 宽度小于parallelCutoff的层直接由调用线程处理；各缓冲区只增不减，重复遍历不再分配内存。
+ */
+template<class Access>
+class parallelLevelTraversal
+{
+public:
+    typedef typename Access::node_type node_type;
+
+    parallelLevelTraversal(threadPool& _pool, const Access& _access = Access()):
+        pool(_pool),
+        access(_access),
+        buffers(_pool.size()),
+        offsets(_pool.size() + 1)
+    {
+    }
+
+    /**
+     * @brief reserve 预留各层的缓冲区，之后的遍历不再分配内存
+     * @param width 最宽一层的上界，见levelWidthBound
+     */
+    void reserve(std::size_t width)
+    {
+        frontier.reserve(width);
+        next.reserve(width);
+        // 每个线程分到不超过⌈width / n⌉个结点，产生的孩子不超过其2倍
+        std::size_t n = buffers.size();
+        std::size_t slice = std::min(width, 2 * ((width + n - 1) / n));
+        for(std::vector<node_type>& b : buffers)
+            b.reserve(slice);
+    }
+
+    // 宽度小于cutoff的层不并行
+    void setParallelCutoff(std::size_t cutoff) { parallelCutoff = cutoff; }
+
+    /**
+     * @brief traverse 层序遍历，要求树未线索化
+     * @param root 根结点
+     * @param visit 访问操作visit(node, workerId)
+     * @param onLevel 每层处理完后由调用线程调用onLevel(depth, width)，可用于逐层计时
+     */
+    template<class Visitor, class LevelHook>
+    void traverse(node_type root, Visitor visit, LevelHook onLevel)
+    {
+        frontier.clear();
+        if(root != access.null())
+            frontier.push_back(root);
+
+        for(std::size_t depth = 0; !frontier.empty(); ++depth){
+            std::size_t width = frontier.size();
+            if(width < parallelCutoff || pool.size() == 1)
+                expand(0, 0, width, visit, next);
+            else
+                expandParallel(width, visit);
+            onLevel(depth, width);
+            frontier.swap(next);
+            next.clear();
+        }
+    }
+
+    template<class Visitor>
+    void traverse(node_type root, Visitor visit)
+    {
+        traverse(root, visit, [](std::size_t, std::size_t){});
+    }
+
+private:
+    threadPool& pool;
+    Access access;
+    std::size_t parallelCutoff = 1 << 12;
+
+    std::vector<node_type> frontier, next;          // 当前层与下一层
+    std::vector<std::vector<node_type> > buffers;   // 各工作线程产生的下一层片段
+    std::vector<std::size_t> offsets;               // 各片段在下一层中的起始位置
+
+    // 访问frontier[begin, end)，孩子追加到out
+    template<class Visitor>
+    void expand(unsigned id, std::size_t begin, std::size_t end, Visitor& visit, std::vector<node_type>& out)
+    {
+        for(std::size_t i = begin; i < end; ++i){
+            node_type p = frontier[i];
+            visit(p, id);
+            node_type l = access.left(p), r = access.right(p);
+            if(l != access.null())
+                out.push_back(l);
+            if(r != access.null())
+                out.push_back(r);
+        }
+    }
+
+    // 一层的并行任务（任务对象只捕获两个指针，std::function不必分配内存）
+    template<class Visitor>
+    struct levelJob
+    {
+        std::size_t width;
+        Visitor* visit;
+    };
+
+    template<class Visitor>
+    void expandParallel(std::size_t width, Visitor& visit)
+    {
+        unsigned workerNum = pool.size();
+        levelJob<Visitor> job{width, &visit};
+        levelJob<Visitor>* pjob = &job;
+        pool.run([this, pjob](unsigned id){
+            unsigned n = pool.size();
+            buffers[id].clear();
+            expand(id, pjob->width * id / n, pjob->width * (id + 1) / n, *pjob->visit, buffers[id]);
+        });
+
+        // 按线程顺序拼接，各线程并行复制自己的片段
+        offsets.assign(workerNum + 1, 0);
+        for(unsigned id = 0; id < workerNum; ++id)
+            offsets[id + 1] = offsets[id] + buffers[id].size();
+        next.resize(offsets[workerNum]);
+        pool.run([this](unsigned id){
+            std::copy(buffers[id].begin(), buffers[id].end(), next.begin() + std::ptrdiff_t(offsets[id]));
+        });
+    }
+};
+
+#endif // PARALLELREDUCE_H
@@ -0,0 +1,56 @@
+#ifndef TAGGEDNODE_H
+#define TAGGEDNODE_H
+
+#include <cstdint>
+#include "binarytreenode.h"
+
+/*
+ * 带标记的孩子指针
+ * 结点至少按2字节对齐，指针的最低位总为0，用它存放LINK/THREAD标记（LINK为0，THREAD为1），
+ * 一次读取即同时得到孩子与标记，线索遍历每一步只读一个字
+ */
+template<class Node>
+class taggedLink
+{
+public:
+    Node* get() const { return reinterpret_cast<Node*>(bits & ~std::uintptr_t(1)); }
+    binaryTreeNode::TAG tag() const { return binaryTreeNode::TAG(bits & 1); }
+
+    void set(Node* node, binaryTreeNode::TAG tag)
+    {
+        bits = reinterpret_cast<std::uintptr_t>(node) | std::uintptr_t(tag == binaryTreeNode::THREAD);
+    }
+
+private:
+    std::uintptr_t bits = 0;    // 空指针且为LINK
+};
+
+
+// 轻量的线索二叉树结点：没有虚函数，孩子与标记合在一个字中，每个结点只有三个指针
+struct taggedNode
+{
+    taggedLink<taggedNode> leftLink, rightLink;
+    taggedNode* parentNode = nullptr;     // 供后序线索遍历求后继
+};
+
+static_assert(alignof(taggedNode) >= 2, "the lowest bit of a taggedNode pointer holds the tag");
+
+
+// taggedNode的结点访问策略：孩子与标记读自同一个字，内联后编译器只读一次
+struct taggedNodeAccess
+{
+    typedef taggedNode* node_type;
+
+    node_type null() const { return nullptr; }
+    node_type left(node_type n) const { return n->leftLink.get(); }
+    node_type right(node_type n) const { return n->rightLink.get(); }
+    binaryTreeNode::TAG leftTag(node_type n) const { return n->leftLink.tag(); }
+    binaryTreeNode::TAG rightTag(node_type n) const { return n->rightLink.tag(); }
+    node_type leftAndTag(node_type n, binaryTreeNode::TAG& tag) const { taggedLink<taggedNode> l = n->leftLink; tag = l.tag(); return l.get(); }
+    node_type rightAndTag(node_type n, binaryTreeNode::TAG& tag) const { taggedLink<taggedNode> r = n->rightLink; tag = r.tag(); return r.get(); }
+    node_type parent(node_type n) const { return n->parentNode; }
+    void setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const { n->leftLink.set(c, tag); }
+    void setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const { n->rightLink.set(c, tag); }
+};
+
+#endif // TAGGEDNODE_H
@@ -0,0 +1,76 @@
+#include "threadpool.h"
+
+/**
+ * @brief threadPool::threadPool 创建threadNum - 1个常驻工作线程
+ * @param threadNum 工作线程数（含调用线程），为0时按1处理
+ */
+threadPool::threadPool(unsigned threadNum)
+{
+    if(threadNum == 0)
+        threadNum = 1;
+    for(unsigned i = 1; i < threadNum; ++i)
+        threads.emplace_back(&threadPool::workerLoop, this, i);
+}
+
+threadPool::~threadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCond.notify_all();
+    for(std::thread& t : threads)
+        t.join();
+}
+
+unsigned threadPool::size() const
+{
+    return unsigned(threads.size()) + 1;
+}
+
+/**
+ * @brief threadPool::run 在所有工作线程上执行job，调用线程执行job(0)
+ * @param job 以工作线程编号为参数的任务
+ */
+void threadPool::run(const std::function<void(unsigned)>& _job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &_job;
+        remaining = unsigned(threads.size());
+        ++generation;
+    }
+    startCond.notify_all();
+
+    _job(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCond.wait(lock, [this]{ return remaining == 0; });
+    job = nullptr;
+}
+
+/**
+ * @brief threadPool::workerLoop 工作线程等待新一轮任务
+ * @param workerId 工作线程编号
+ */
+void threadPool::workerLoop(unsigned workerId)
+{
+    unsigned seen = 0;
+    while(true){
+        const std::function<void(unsigned)>* cur;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCond.wait(lock, [this, seen]{ return stopping || generation != seen; });
+            if(stopping)
+                return;
+            seen = generation;
+            cur = job;
+        }
+
+        (*cur)(workerId);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--remaining == 0)
+            doneCond.notify_one();
+    }
+}
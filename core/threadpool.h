@@ -0,0 +1,38 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 常驻线程池：run()让每个工作线程各执行一次任务，调用线程作为0号工作线程参与
+// 任务之间的负载均衡（工作窃取）由具体任务自己实现，见parallelreduce.h
+class threadPool
+{
+public:
+    explicit threadPool(unsigned threadNum = std::thread::hardware_concurrency());
+    ~threadPool();
+    threadPool(const threadPool&) = delete;
+    threadPool& operator=(const threadPool&) = delete;
+
+    // 工作线程数（含调用线程）
+    unsigned size() const;
+
+    // 在所有工作线程上执行job(workerId)，全部完成后返回
+    void run(const std::function<void(unsigned)>& job);
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable startCond, doneCond;
+    const std::function<void(unsigned)>* job = nullptr;
+    unsigned generation = 0;    // 每次run加一，唤醒工作线程
+    unsigned remaining = 0;     // 尚未完成的工作线程数
+    bool stopping = false;
+
+    void workerLoop(unsigned workerId);
+};
+
+#endif // THREADPOOL_H
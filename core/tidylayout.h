@@ -0,0 +1,320 @@
+#ifndef TIDYLAYOUT_H
+#define TIDYLAYOUT_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "binarytreenode.h"
+
+/*
+ * 二叉树的整洁布局（Reingold–Tilford算法，O(n)）
+ * 自底向上合并左右子树：沿左子树的右轮廓与右子树的左轮廓逐层比较，求出两棵子树的最小间距，
+ * 较浅一侧的最深结点挂上轮廓线索，使上层合并时只需沿轮廓行走，总代价与结点数成线性。
+ * 只有一个孩子时仍偏向对应一侧，左右孩子一目了然。
+ * 轮廓线索保存在布局自己的数组中，不修改树，线索化后的树同样适用（只沿LINK走）。
+ *
+ * 新增结点后调用insert()增量更新：只撤销并重算从新结点到根路径上各结点的合并结果，
+ * 再自上而下只更新坐标发生变化的结点。
+ *
+ * Index把结点映射为从0开始的稠密编号，布局数据按编号存放。
+ */
+
+// 结点本身即为编号（如arrayTree的下标）
+struct identityIndex
+{
+    template<class Node>
+    std::size_t operator()(Node n) const { return std::size_t(n); }
+};
+
+template<class Access, class Index = identityIndex>
+class tidyLayout
+{
+public:
+    typedef typename Access::node_type node_type;
+
+    explicit tidyLayout(const Access& _access = Access(), const Index& _index = Index()):
+        access(_access),
+        index(_index)
+    {
+    }
+
+    // 同层相邻结点的最小水平间距与层间距
+    void setSeparation(float sibling, float level)
+    {
+        siblingSeparation = sibling;
+        levelSeparation = level;
+    }
+
+    /**
+     * @brief layout 对整棵树重新布局，根位于(0, 0)
+     * @param root 根结点
+     * @param moved 每个结点的坐标确定后调用moved(node, x, y)
+     */
+    template<class Moved>
+    void layout(node_type root, Moved&& moved)
+    {
+        if(root == access.null())
+            return;
+        reserve(index(root));
+        level[index(root)] = 0;
+        x[index(root)] = 0;
+        setupSubtree(root);
+        petrify(root, true, moved);
+    }
+
+    /**
+     * @brief insert 结点（可带子树）挂到已布局的树上后，增量更新布局
+     * @param node 新结点，双亲指针须已设置
+     * @param moved 坐标发生变化的结点调用moved(node, x, y)
+     */
+    template<class Moved>
+    void insert(node_type node, Moved&& moved)
+    {
+        node_type parent = access.parent(node);
+        if(parent == access.null()){
+            layout(node, moved);
+            return;
+        }
+
+        // 新子树的层号，并撤销路径上各结点原先挂的轮廓线索
+        level[reserve(index(node))] = level[index(parent)] + 1;
+        path.clear();
+        for(node_type p = parent; p != access.null(); p = access.parent(p)){
+            path.push_back(p);
+            undoThread(p);
+        }
+
+        // 自底向上重算
+        setupSubtree(node);
+        for(node_type p : path)
+            setupNode(p);
+
+        // 自上而下更新坐标，只进入路径上的结点与位置变化的子树
+        node_type root = path.back();
+        for(std::size_t i = path.size(); i-- > 0; )
+            dirty[index(path[i])] = 1;
+        dirty[index(node)] = 1;
+        petrify(root, false, moved);
+        for(node_type p : path)
+            dirty[index(p)] = 0;
+        dirty[index(node)] = 0;
+
+        // 新子树中的编号可能是复用的，旧坐标不可信，整体重新求一遍
+        if(linkedLeft(node) != access.null() || linkedRight(node) != access.null())
+            petrify(node, true, moved);
+    }
+
+    float getX(node_type n) const { return x[index(n)]; }
+    float getY(node_type n) const { return float(level[index(n)]) * levelSeparation; }
+
+private:
+    // 子树最深一层的最左/最右结点，offset为其相对子树根的水平偏移
+    struct extreme
+    {
+        node_type node;
+        float offset;
+        std::int32_t level;
+    };
+
+    Access access;
+    Index index;
+    float siblingSeparation = 1;
+    float levelSeparation = 1;
+
+    // 按编号存放的布局数据
+    std::vector<float> offset;              // 孩子相对本结点的水平距离（两个孩子对称）；带线索的叶子为到线索目标的距离
+    std::vector<node_type> contourLeft;     // 轮廓上的下一个结点：孩子或线索
+    std::vector<node_type> contourRight;
+    std::vector<node_type> threaded;        // 合并本结点的子树时挂上线索的叶子
+    std::vector<extreme> leftMost, rightMost;
+    std::vector<std::int32_t> level;
+    std::vector<float> x;
+    std::vector<char> dirty;
+
+    std::vector<node_type> stack, order, path;
+
+    node_type linkedLeft(node_type n) const { return access.leftTag(n) == binaryTreeNode::LINK ? access.left(n) : access.null(); }
+    node_type linkedRight(node_type n) const { return access.rightTag(n) == binaryTreeNode::LINK ? access.right(n) : access.null(); }
+
+    std::size_t reserve(std::size_t i)
+    {
+        if(i >= offset.size()){
+            std::size_t n = i + 1 > offset.size() * 2 ? i + 1 : offset.size() * 2;
+            offset.resize(n, 0);
+            contourLeft.resize(n, access.null());
+            contourRight.resize(n, access.null());
+            threaded.resize(n, access.null());
+            leftMost.resize(n);
+            rightMost.resize(n);
+            level.resize(n, 0);
+            x.resize(n, 0);
+            dirty.resize(n, 0);
+        }
+        return i;
+    }
+
+    // 撤销合并n的子树时挂上的线索
+    void undoThread(node_type n)
+    {
+        node_type leaf = threaded[index(n)];
+        if(leaf == access.null())
+            return;
+        std::size_t i = index(leaf);
+        contourLeft[i] = linkedLeft(leaf);
+        contourRight[i] = linkedRight(leaf);
+        offset[i] = 0;
+        threaded[index(n)] = access.null();
+    }
+
+    // 对以root为根的子树自底向上逐个合并（root的层号须已设置）
+    void setupSubtree(node_type root)
+    {
+        // 先序记录结点并求层号，逆序即保证孩子先于双亲
+        order.clear();
+        stack.clear();
+        stack.push_back(root);
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            stack.pop_back();
+            order.push_back(cur);
+            std::int32_t childLevel = level[index(cur)] + 1;
+            node_type l = linkedLeft(cur), r = linkedRight(cur);
+            if(l != access.null()){
+                level[reserve(index(l))] = childLevel;
+                stack.push_back(l);
+            }
+            if(r != access.null()){
+                level[reserve(index(r))] = childLevel;
+                stack.push_back(r);
+            }
+        }
+        for(std::size_t i = order.size(); i-- > 0; )
+            setupNode(order[i]);
+    }
+
+    // 合并结点t的左右子树（孩子已合并完毕）
+    void setupNode(node_type t)
+    {
+        std::size_t ti = index(t);
+        node_type L = linkedLeft(t), R = linkedRight(t);
+        contourLeft[ti] = L;
+        contourRight[ti] = R;
+        threaded[ti] = access.null();
+
+        if(L == access.null() && R == access.null()){
+            offset[ti] = 0;
+            leftMost[ti] = rightMost[ti] = extreme{t, 0, level[ti]};
+            return;
+        }
+
+        // 逐层比较左子树的右轮廓与右子树的左轮廓
+        float curSeparation = siblingSeparation, rootSeparation = siblingSeparation;
+        float leftOffsetSum = 0, rightOffsetSum = 0;
+        node_type l = L, r = R;
+        while(l != access.null() && r != access.null()){
+            if(curSeparation < siblingSeparation){
+                rootSeparation += siblingSeparation - curSeparation;
+                curSeparation = siblingSeparation;
+            }
+            std::size_t li = index(l), ri = index(r);
+            if(contourRight[li] != access.null()){
+                leftOffsetSum += offset[li];
+                curSeparation -= offset[li];
+                l = contourRight[li];
+            }
+            else{
+                leftOffsetSum -= offset[li];
+                curSeparation += offset[li];
+                l = contourLeft[li];
+            }
+            if(contourLeft[ri] != access.null()){
+                rightOffsetSum -= offset[ri];
+                curSeparation -= offset[ri];
+                r = contourLeft[ri];
+            }
+            else{
+                rightOffsetSum += offset[ri];
+                curSeparation += offset[ri];
+                r = contourRight[ri];
+            }
+        }
+
+        float half = rootSeparation / 2;
+        offset[ti] = half;
+        leftOffsetSum -= half;      // 此后两者均相对t
+        rightOffsetSum += half;
+
+        // 更新最深一层的最左/最右结点
+        extreme LL{access.null(), 0, -1}, LR = LL, RL = LL, RR = LL;
+        if(L != access.null()){
+            LL = leftMost[index(L)];
+            LR = rightMost[index(L)];
+        }
+        if(R != access.null()){
+            RL = leftMost[index(R)];
+            RR = rightMost[index(R)];
+        }
+        if(RL.level > LL.level || L == access.null())
+            leftMost[ti] = extreme{RL.node, RL.offset + half, RL.level};
+        else
+            leftMost[ti] = extreme{LL.node, LL.offset - half, LL.level};
+        if(LR.level > RR.level || R == access.null())
+            rightMost[ti] = extreme{LR.node, LR.offset - half, LR.level};
+        else
+            rightMost[ti] = extreme{RR.node, RR.offset + half, RR.level};
+
+        // 较浅一侧的最深结点挂上指向另一侧轮廓的线索
+        if(l != access.null() && l != L){
+            std::size_t ai = index(RR.node);
+            float from = RR.offset + half, to = leftOffsetSum;
+            offset[ai] = std::fabs(to - from);
+            if(to >= from)
+                contourRight[ai] = l;
+            else
+                contourLeft[ai] = l;
+            threaded[ti] = RR.node;
+        }
+        else if(r != access.null() && r != R){
+            std::size_t ai = index(LL.node);
+            float from = LL.offset - half, to = rightOffsetSum;
+            offset[ai] = std::fabs(to - from);
+            if(to >= from)
+                contourRight[ai] = r;
+            else
+                contourLeft[ai] = r;
+            threaded[ti] = LL.node;
+        }
+    }
+
+    // 自上而下由相对偏移求坐标；all为false时只进入dirty结点与位置变化的子树
+    template<class Moved>
+    void petrify(node_type root, bool all, Moved& moved)
+    {
+        stack.clear();
+        stack.push_back(root);
+        if(all)
+            moved(root, x[index(root)], getY(root));
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            stack.pop_back();
+            std::size_t ci = index(cur);
+            node_type children[2] = { linkedLeft(cur), linkedRight(cur) };
+            for(int k = 0; k < 2; ++k){
+                node_type c = children[k];
+                if(c == access.null())
+                    continue;
+                std::size_t i = index(c);
+                float nx = k == 0 ? x[ci] - offset[ci] : x[ci] + offset[ci];
+                bool changed = all || nx != x[i] || dirty[i];
+                x[i] = nx;
+                if(changed){
+                    moved(c, nx, getY(c));
+                    stack.push_back(c);
+                }
+            }
+        }
+    }
+};
+
+#endif // TIDYLAYOUT_H
@@ -0,0 +1,775 @@
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+#include <cstddef>
+#include <vector>
+#include "binarytreenode.h"
+#include "traversalmetrics.h"
+
+/*
+ * 编译期特化的遍历算法
+ * 遍历顺序（Order）、结点访问方式（Access）和访问操作（Visitor）均为模板参数，
+ * 编译器可将整个遍历循环内联展开，热循环中不再有虚函数调用
+ * 统计策略（Stats）默认为noTraversalStats，不产生任何统计代码
+ */
+
+// 遍历顺序策略
+struct preOrder {};
+struct inOrder {};
+struct postOrder {};
+struct levelOrder {};
+
+
+// 结点访问策略：通过虚函数访问任意binaryTreeNode（兼容原有接口）
+struct virtualNodeAccess
+{
+    typedef binaryTreeNode* node_type;
+
+    node_type null() const { return nullptr; }
+    node_type left(node_type n) const { return n->getLeftChild(); }
+    node_type right(node_type n) const { return n->getRightChild(); }
+    binaryTreeNode::TAG leftTag(node_type n) const { return n->getLeftChildTag(); }
+    binaryTreeNode::TAG rightTag(node_type n) const { return n->getRightChildTag(); }
+    node_type leftAndTag(node_type n, binaryTreeNode::TAG& tag) const { return n->getLeftLink(tag); }
+    node_type rightAndTag(node_type n, binaryTreeNode::TAG& tag) const { return n->getRightLink(tag); }
+    node_type parent(node_type n) const { return n->getParentNode(); }
+    void setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const { n->setLeftChild(c, tag); }
+    void setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const { n->setRightChild(c, tag); }
+};
+
+
+// 结点访问策略：已知具体结点类型时，用限定名调用绕过虚函数分派，便于内联
+template<class Node>
+struct concreteNodeAccess
+{
+    typedef Node* node_type;
+
+    node_type null() const { return nullptr; }
+    node_type left(node_type n) const { return static_cast<Node*>(n->Node::getLeftChild()); }
+    node_type right(node_type n) const { return static_cast<Node*>(n->Node::getRightChild()); }
+    binaryTreeNode::TAG leftTag(node_type n) const { return n->Node::getLeftChildTag(); }
+    binaryTreeNode::TAG rightTag(node_type n) const { return n->Node::getRightChildTag(); }
+    node_type leftAndTag(node_type n, binaryTreeNode::TAG& tag) const { tag = leftTag(n); return left(n); }
+    node_type rightAndTag(node_type n, binaryTreeNode::TAG& tag) const { tag = rightTag(n); return right(n); }
+    node_type parent(node_type n) const { return static_cast<Node*>(n->Node::getParentNode()); }
+    void setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const { n->Node::setLeftChild(c, tag); }
+    void setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const { n->Node::setRightChild(c, tag); }
+};
+
+
+// 栈式遍历的暂存区：由调用方持有并按树高预先分配（遍历的栈深不超过树高），
+// 多次遍历反复使用，稳态下不再分配内存；树高估计不足时按倍增扩充，不影响正确性
+// 层序遍历把它用作环形队列，按层宽的上界预留后同样不再分配内存
+template<class NodeType>
+class traversalArena
+{
+public:
+    explicit traversalArena(std::size_t height = 0)
+    {
+        reserve(height);
+    }
+
+    // 保证能容纳高为height的树的遍历
+    void reserve(std::size_t height)
+    {
+        if(height > buffer.size())
+            buffer.resize(height);
+    }
+
+    // 保证能作为容纳width个结点的环形队列（容量为不小于width的2的幂）
+    void reserveQueue(std::size_t width)
+    {
+        std::size_t size = 1;
+        while(size < width)
+            size *= 2;
+        if(width)
+            reserve(size);
+    }
+
+    std::size_t capacity() const { return buffer.size(); }
+    NodeType* data() { return buffer.data(); }
+
+    // 容量用尽时扩充（已有的size个元素保留），返回新的起始地址
+    NodeType* grow(std::size_t size)
+    {
+        buffer.resize(size < 32 ? 64 : 2 * size);
+        return buffer.data();
+    }
+
+private:
+    std::vector<NodeType> buffer;
+};
+
+
+// 层序遍历中队列长度（及最宽一层）的上界：队列中的结点互不为祖先，各有不同的叶子后代，
+// 因此不超过叶子数，也不超过同高满二叉树最后一层的宽度
+inline std::size_t levelWidthBound(std::size_t height, std::size_t leafNum)
+{
+    if(height == 0)
+        return 0;
+    if(height - 1 < sizeof(std::size_t) * 8 && (std::size_t(1) << (height - 1)) < leafNum)
+        return std::size_t(1) << (height - 1);
+    return leafNum;
+}
+
+
+// 遍历算法（以访问策略与统计策略为参数）
+template<class Access, class Stats = noTraversalStats>
+class treeTraversal
+{
+public:
+    typedef typename Access::node_type node_type;
+    typedef traversalArena<node_type> arena_type;
+
+    explicit treeTraversal(const Access& _access = Access()):
+        access(_access)
+    {
+    }
+
+    // 栈式遍历（使用内部的暂存区，首次遍历时按需扩充）
+    template<class Order, class Visitor>
+    void traversal(node_type root, Visitor&& visit)
+    {
+        traversal<Order>(root, visit, scratch);
+    }
+
+    // 栈式遍历，使用调用方按树高预先分配的暂存区，不分配内存、不压空指针
+    // Order为levelOrder时为层序遍历（暂存区用作环形队列），要求树未线索化
+    template<class Order, class Visitor>
+    void traversal(node_type root, Visitor&& visit, arena_type& arena)
+    {
+        countedVisitor<Visitor> counted{visit, stats};
+        if(root != access.null())
+            traversal(Order(), root, counted, arena);
+    }
+
+    // 层序遍历，每访问完一层调用onLevel(depth, width)（根所在层depth为0），可用于逐层计时
+    template<class Visitor, class LevelHook>
+    void levelTraversal(node_type root, Visitor&& visit, LevelHook&& onLevel, arena_type& arena)
+    {
+        countedVisitor<Visitor> counted{visit, stats};
+        if(root != access.null())
+            levelKernel(root, counted, onLevel, arena);
+    }
+
+    // 已线索化的二叉树遍历（后序需要双亲指针）
+    template<class Order, class Visitor>
+    void traversal_Thr(node_type root, Visitor&& visit)
+    {
+        countedVisitor<Visitor> counted{visit, stats};
+        traversal_Thr(Order(), root, counted);
+    }
+
+    // Morris遍历：临时借用空右孩子作线索，不需要额外栈空间，遍历结束后树恢复原状
+    // 要求树未线索化
+    template<class Order, class Visitor>
+    void traversal_Morris(node_type root, Visitor&& visit)
+    {
+        countedVisitor<Visitor> counted{visit, stats};
+        traversal_Morris(Order(), root, counted);
+    }
+
+    // 线索化（结点按进入顺序交给visit，按Order的位置线索化）
+    template<class Order, class Visitor>
+    void createThreadedTree(node_type root, Visitor&& visit)
+    {
+        pre = access.null();
+
+        if(root != access.null()){
+            countedVisitor<Visitor> counted{visit, stats};
+            createThreadedTree(Order(), root, counted);
+            if(pre != access.null() && right(pre) == access.null())
+                access.setRight(pre, access.null(), binaryTreeNode::THREAD);
+        }
+    }
+
+    // 清除线索（迭代实现，不受树高限制）
+    void clearThreadedTree(node_type root)
+    {
+        stack.clear();
+        if(root != access.null())
+            push(stack, root);
+
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            pop(stack);
+            if(access.leftTag(cur) == binaryTreeNode::LINK){
+                if(left(cur) != access.null())
+                    push(stack, left(cur));
+            }
+            else
+                access.setLeft(cur, access.null(), binaryTreeNode::LINK);
+            if(access.rightTag(cur) == binaryTreeNode::LINK){
+                if(right(cur) != access.null())
+                    push(stack, right(cur));
+            }
+            else
+                access.setRight(cur, access.null(), binaryTreeNode::LINK);
+        }
+    }
+
+    // 统计叶子结点数（迭代实现，只沿LINK走，线索化后也能正确统计）
+    std::size_t countLeafNode(node_type root)
+    {
+        std::size_t leafNum = 0;
+
+        stack.clear();
+        if(root != access.null())
+            push(stack, root);
+
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            pop(stack);
+            node_type l = linkedLeft(cur), r = linkedRight(cur);
+            if(l == access.null() && r == access.null())
+                ++leafNum;
+            if(r != access.null())
+                push(stack, r);
+            if(l != access.null())
+                push(stack, l);
+        }
+        return leafNum;
+    }
+
+    // 统计信息（Stats为noTraversalStats时为空）
+    Stats& getStats() { return stats; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    // 线索化时的遍历阶段
+    enum STAGE : unsigned char { ENTER, LEFT_DONE, RIGHT_DONE };
+
+    Access access;
+    Stats stats;
+    node_type pre = node_type();    // 存储遍历时的前一个结点 用于线索化
+
+    // 可复用的显式栈（只clear不释放，多次调用不再分配内存）
+    std::vector<node_type> stack;
+    std::vector<STAGE> stage;
+    arena_type scratch;         // 未指定暂存区时栈式遍历使用
+
+    // 暂存区上的定长栈，容量不足时才扩充暂存区
+    struct scratchStack
+    {
+        arena_type& arena;
+        node_type* base;
+        std::size_t top = 0;
+        std::size_t capacity;
+
+        explicit scratchStack(arena_type& _arena):
+            arena(_arena), base(_arena.data()), capacity(_arena.capacity())
+        {
+        }
+
+        bool empty() const { return top == 0; }
+        std::size_t size() const { return top; }
+        node_type back() const { return base[top - 1]; }
+
+        void push_back(node_type n)
+        {
+            if(top == capacity){
+                base = arena.grow(top);
+                capacity = arena.capacity();
+            }
+            base[top++] = n;
+        }
+
+        void pop_back() { --top; }
+    };
+
+    // 暂存区上的环形队列，容量为2的幂，满时倍增
+    struct ringQueue
+    {
+        arena_type& arena;
+        node_type* base;
+        std::size_t head = 0;
+        std::size_t count = 0;
+        std::size_t capacity;
+
+        explicit ringQueue(arena_type& _arena):
+            arena(_arena), base(_arena.data()), capacity(floorPowerOfTwo(_arena.capacity()))
+        {
+        }
+
+        static std::size_t floorPowerOfTwo(std::size_t n)
+        {
+            std::size_t p = 1;
+            while(p <= n / 2)
+                p *= 2;
+            return n ? p : 0;
+        }
+
+        bool empty() const { return count == 0; }
+        std::size_t size() const { return count; }
+        node_type front() const { return base[head]; }
+
+        void push_back(node_type n)
+        {
+            if(count == capacity)
+                grow();
+            base[(head + count++) & (capacity - 1)] = n;
+        }
+
+        void pop_front()
+        {
+            head = (head + 1) & (capacity - 1);
+            --count;
+        }
+
+        void grow()
+        {
+            std::size_t old = capacity;
+            base = arena.grow(old);
+            capacity = floorPowerOfTwo(arena.capacity());
+            // 队列已满，绕回开头的[0, head)接到原有部分之后
+            for(std::size_t i = 0; i < head; ++i)
+                base[old + i] = base[i];
+        }
+    };
+
+    node_type left(node_type n) const { return access.left(n); }
+    node_type right(node_type n) const { return access.right(n); }
+
+    // 取得孩子（或线索）c，返回标记是否为LINK；孩子与标记一次取得
+    bool leftIsLink(node_type n, node_type& c) const
+    {
+        binaryTreeNode::TAG tag;
+        c = access.leftAndTag(n, tag);
+        return tag == binaryTreeNode::LINK;
+    }
+
+    bool rightIsLink(node_type n, node_type& c) const
+    {
+        binaryTreeNode::TAG tag;
+        c = access.rightAndTag(n, tag);
+        return tag == binaryTreeNode::LINK;
+    }
+
+    // 沿LINK的孩子（线索视为空）
+    node_type linkedLeft(node_type n) const { node_type c; return leftIsLink(n, c) ? c : access.null(); }
+    node_type linkedRight(node_type n) const { node_type c; return rightIsLink(n, c) ? c : access.null(); }
+
+    // 访问结点前先计数
+    template<class Visitor>
+    struct countedVisitor
+    {
+        Visitor& visit;
+        Stats& stats;
+
+        void operator()(node_type n)
+        {
+            stats.visit();
+            visit(n);
+        }
+    };
+
+    // 带统计的压栈/出栈
+    template<class Stack>
+    void push(Stack& s, node_type n)
+    {
+        s.push_back(n);
+        stats.push(s.size());
+        if(n == access.null())
+            stats.nullSentinel();
+    }
+
+    template<class Stack>
+    void pop(Stack& s)
+    {
+        s.pop_back();
+        stats.pop();
+    }
+
+    // 即将沿p的右指针前进，若为线索则计数（不统计时不读取标记）
+    void countRightThread(node_type p)
+    {
+        if(Stats::enabled && access.rightTag(p) == binaryTreeNode::THREAD)
+            stats.followThread();
+    }
+
+    void pushFrame(node_type n)
+    {
+        push(stack, n);
+        stage.push_back(ENTER);
+    }
+
+    void popFrame()
+    {
+        pop(stack);
+        stage.pop_back();
+    }
+
+    // 以下栈式遍历只压入非空结点，要求root非空
+    // 前序：栈中只存放待访问的右子树，栈深不超过树高
+    template<class Visitor>
+    void traversal(preOrder, node_type root, Visitor& visit, arena_type& arena)
+    {
+        scratchStack s(arena);
+        node_type p = root, l, r;
+        while(true){
+            visit(p);
+            l = left(p);
+            r = right(p);
+            if(l != access.null()){
+                if(r != access.null())
+                    push(s, r);     // 右子树留待左子树访问完
+                p = l;
+            }
+            else if(r != access.null())
+                p = r;
+            else if(!s.empty()){
+                p = s.back();
+                pop(s);
+            }
+            else
+                break;
+        }
+    }
+
+    // 中序：栈中为从根到当前结点路径上尚未访问的祖先
+    template<class Visitor>
+    void traversal(inOrder, node_type root, Visitor& visit, arena_type& arena)
+    {
+        scratchStack s(arena);
+        node_type p = root;
+        while(true){
+            for(; p != access.null(); p = left(p))
+                push(s, p);
+            if(s.empty())
+                break;
+            p = s.back();
+            pop(s);
+            visit(p);
+            p = right(p);
+        }
+    }
+
+    // 后序：栈中为当前路径，last为上一个访问的结点，据此判断右子树是否已访问
+    template<class Visitor>
+    void traversal(postOrder, node_type root, Visitor& visit, arena_type& arena)
+    {
+        scratchStack s(arena);
+        node_type p = root, last = access.null(), r;
+        while(true){
+            for(; p != access.null(); p = left(p))
+                push(s, p);
+            while(true){
+                if(s.empty())
+                    return;
+                p = s.back();
+                r = right(p);
+                if(r != access.null() && r != last){
+                    p = r;      // 转入右子树
+                    break;
+                }
+                pop(s);
+                visit(p);
+                last = p;
+            }
+        }
+    }
+
+    // 层序：队列中为当前层的剩余部分与下一层已入队的部分
+    struct noLevelHook
+    {
+        void operator()(std::size_t, std::size_t) const {}
+    };
+
+    template<class Visitor>
+    void traversal(levelOrder, node_type root, Visitor& visit, arena_type& arena)
+    {
+        noLevelHook onLevel;
+        levelKernel(root, visit, onLevel, arena);
+    }
+
+    template<class Visitor, class LevelHook>
+    void levelKernel(node_type root, Visitor& visit, LevelHook& onLevel, arena_type& arena)
+    {
+        ringQueue q(arena);
+        node_type p;
+        push(q, root);
+
+        for(std::size_t depth = 0; !q.empty(); ++depth){
+            std::size_t width = q.size();
+            for(std::size_t i = 0; i < width; ++i){
+                p = q.front();
+                q.pop_front();
+                stats.pop();
+                visit(p);
+                if(left(p) != access.null())
+                    push(q, left(p));
+                if(right(p) != access.null())
+                    push(q, right(p));
+            }
+            onLevel(depth, width);
+        }
+    }
+
+    template<class Visitor>
+    void traversal_Thr(preOrder, node_type root, Visitor& visit)
+    {
+        node_type p = root, c;
+        while(p != access.null()){
+            while(leftIsLink(p, c)){
+                visit(p);
+                p = c;
+            }
+            visit(p);
+            countRightThread(p);
+            p = right(p);
+        }
+    }
+
+    template<class Visitor>
+    void traversal_Thr(inOrder, node_type root, Visitor& visit)
+    {
+        node_type p = root, c;
+        while(p != access.null()){
+            while(leftIsLink(p, c))
+                p = c;
+            visit(p);
+            while(!rightIsLink(p, c) && c != access.null()){
+                stats.followThread();
+                p = c;
+                visit(p);
+            }
+            p = c;
+        }
+    }
+
+    // 后序线索树中以n为根的子树的第一个结点（尽量向左、其次向右下降到叶子）
+    node_type firstPostOrder(node_type n) const
+    {
+        node_type c;
+        while(true){
+            if((c = linkedLeft(n)) != access.null())
+                n = c;
+            else if((c = linkedRight(n)) != access.null())
+                n = c;
+            else
+                return n;
+        }
+    }
+
+    // 后序线索树的遍历：右线索直接给出后继，否则借助双亲求后继，O(n)时间、O(1)额外空间
+    template<class Visitor>
+    void traversal_Thr(postOrder, node_type root, Visitor& visit)
+    {
+        if(root == access.null())
+            return;
+
+        node_type p = firstPostOrder(root), q;
+        while(p != access.null()){
+            visit(p);
+            if(!rightIsLink(p, q)){
+                stats.followThread();
+                p = q;
+            }
+            else if((q = access.parent(p)) == access.null())
+                p = access.null();      // 根结点最后访问
+            else if(linkedRight(q) == p || linkedRight(q) == access.null())
+                p = q;                  // 右孩子或无右子树的左孩子，后继为双亲
+            else
+                p = firstPostOrder(linkedRight(q));    // 左孩子，后继为双亲右子树的第一个结点
+        }
+    }
+
+    // 找cur在中序下的前驱（左子树最右结点），遇到指回cur的临时线索即停
+    node_type morrisPredecessor(node_type cur) const
+    {
+        node_type p = left(cur);
+        while(access.rightTag(p) == binaryTreeNode::LINK && right(p) != access.null())
+            p = right(p);
+        return p;
+    }
+
+    template<class Visitor>
+    void traversal_Morris(preOrder, node_type root, Visitor& visit)
+    {
+        node_type cur = root, p;
+        while(cur != access.null()){
+            if(left(cur) == access.null()){
+                visit(cur);
+                countRightThread(cur);  // 可能沿临时线索回到祖先
+                cur = right(cur);
+            }
+            else if(access.rightTag(p = morrisPredecessor(cur)) == binaryTreeNode::LINK){
+                visit(cur);     // 第一次到达，先访问再进入左子树
+                access.setRight(p, cur, binaryTreeNode::THREAD);
+                cur = left(cur);
+            }
+            else{
+                access.setRight(p, access.null(), binaryTreeNode::LINK);   // 第二次到达，恢复
+                cur = right(cur);
+            }
+        }
+    }
+
+    template<class Visitor>
+    void traversal_Morris(inOrder, node_type root, Visitor& visit)
+    {
+        node_type cur = root, p;
+        while(cur != access.null()){
+            if(left(cur) == access.null()){
+                visit(cur);
+                countRightThread(cur);  // 可能沿临时线索回到祖先
+                cur = right(cur);
+            }
+            else if(access.rightTag(p = morrisPredecessor(cur)) == binaryTreeNode::LINK){
+                access.setRight(p, cur, binaryTreeNode::THREAD);
+                cur = left(cur);
+            }
+            else{
+                access.setRight(p, access.null(), binaryTreeNode::LINK);
+                visit(cur);     // 左子树已访问完
+                cur = right(cur);
+            }
+        }
+    }
+
+    template<class Visitor>
+    void traversal_Morris(postOrder, node_type root, Visitor& visit)
+    {
+        node_type cur = root, p;
+        while(cur != access.null()){
+            if(left(cur) == access.null()){
+                countRightThread(cur);
+                cur = right(cur);
+            }
+            else if(access.rightTag(p = morrisPredecessor(cur)) == binaryTreeNode::LINK){
+                access.setRight(p, cur, binaryTreeNode::THREAD);
+                cur = left(cur);
+            }
+            else{
+                access.setRight(p, access.null(), binaryTreeNode::LINK);
+                visitReversed(left(cur), p, visit);     // 逆序访问左孩子到前驱的右链
+                cur = right(cur);
+            }
+        }
+
+        if(root != access.null()){
+            for(p = root; right(p) != access.null(); p = right(p))
+                ;
+            visitReversed(root, p, visit);              // 最后逆序访问根的右链
+        }
+    }
+
+    // 将from到to的右链原地反转，逆序访问后再反转回来
+    template<class Visitor>
+    void visitReversed(node_type from, node_type to, Visitor& visit)
+    {
+        reverseRightChain(from, to);
+        for(node_type p = to; ; p = right(p)){
+            visit(p);
+            if(p == from)
+                break;
+        }
+        reverseRightChain(to, from);
+    }
+
+    void reverseRightChain(node_type from, node_type to)
+    {
+        node_type prev = access.null(), p = from, next;
+        while(true){
+            next = right(p);
+            access.setRight(p, prev, binaryTreeNode::LINK);
+            if(p == to)
+                break;
+            prev = p;
+            p = next;
+        }
+    }
+
+    // 以下线索化均用显式栈模拟递归：结点进入时visit，按Order在对应阶段threading
+    template<class Visitor>
+    void createThreadedTree(preOrder, node_type root, Visitor& visit)
+    {
+        stack.clear();
+        stage.clear();
+        pushFrame(root);
+
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            if(stage.back() == ENTER){
+                visit(cur);
+                threading(cur);
+                stage.back() = LEFT_DONE;
+                if(access.leftTag(cur) == binaryTreeNode::LINK && left(cur) != access.null())
+                    pushFrame(left(cur));
+            }
+            else{
+                popFrame();     // 右子树无需回到本结点，先出栈以免右斜树栈深增长
+                if(access.rightTag(cur) == binaryTreeNode::LINK && right(cur) != access.null())
+                    pushFrame(right(cur));
+            }
+        }
+    }
+
+    template<class Visitor>
+    void createThreadedTree(inOrder, node_type root, Visitor& visit)
+    {
+        stack.clear();
+        stage.clear();
+        pushFrame(root);
+
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            if(stage.back() == ENTER){
+                visit(cur);
+                stage.back() = LEFT_DONE;
+                if(left(cur) != access.null())
+                    pushFrame(left(cur));
+            }
+            else{
+                threading(cur);
+                popFrame();
+                if(right(cur) != access.null())
+                    pushFrame(right(cur));
+            }
+        }
+    }
+
+    template<class Visitor>
+    void createThreadedTree(postOrder, node_type root, Visitor& visit)
+    {
+        stack.clear();
+        stage.clear();
+        pushFrame(root);
+
+        while(!stack.empty()){
+            node_type cur = stack.back();
+            switch(stage.back()){
+                case ENTER:
+                    visit(cur);
+                    stage.back() = LEFT_DONE;
+                    if(left(cur) != access.null())
+                        pushFrame(left(cur));
+                    break;
+                case LEFT_DONE:
+                    stage.back() = RIGHT_DONE;
+                    if(right(cur) != access.null())
+                        pushFrame(right(cur));
+                    break;
+                case RIGHT_DONE:
+                    threading(cur);
+                    popFrame();
+                    break;
+            }
+        }
+    }
+
+    // 实现某结点的threading
+    void threading(node_type cur)
+    {
+        stats.threading();
+        if(left(cur) == access.null())
+            access.setLeft(cur, pre, binaryTreeNode::THREAD);
+
+        if(pre != access.null() && right(pre) == access.null())
+            access.setRight(pre, cur, binaryTreeNode::THREAD);
+
+        pre = cur;
+    }
+};
+
+#endif // TRAVERSAL_H
@@ -0,0 +1,47 @@
+#include "traversalmetrics.h"
+#include <cstdio>
+
+const char* traversalMetrics::phaseName(PHASE phase)
+{
+    static const char* names[PHASE_NUM] = { "threading", "traversal", "clearThread", "countLeaf" };
+    return names[phase];
+}
+
+void traversalMetrics::addLevel(std::size_t depth, std::size_t width, std::uint64_t nanoseconds)
+{
+    if(depth >= levels.size())
+        levels.resize(depth + 1, levelTiming{0, 0});
+    levels[depth].width = width;
+    levels[depth].nanoseconds += nanoseconds;
+}
+
+/**
+ * @brief traversalMetrics::toJson 导出为JSON对象（单行）
+ * @return 形如{"visited":..., ..., "phaseNanoseconds":{"threading":..., ...}, "levels":[{"width":..., "nanoseconds":...}, ...]}
+ */
+std::string traversalMetrics::toJson() const
+{
+    char buffer[512];
+    std::snprintf(buffer, sizeof(buffer),
+                  "{\"visited\":%llu,\"stackPushes\":%llu,\"stackPops\":%llu,\"peakStackDepth\":%llu,"
+                  "\"nullSentinels\":%llu,\"threadLinksFollowed\":%llu,\"threadingCalls\":%llu,\"phaseNanoseconds\":{",
+                  (unsigned long long)counters.visitedNum, (unsigned long long)counters.pushNum,
+                  (unsigned long long)counters.popNum, (unsigned long long)counters.peakStackDepth,
+                  (unsigned long long)counters.nullSentinelNum, (unsigned long long)counters.threadFollowedNum,
+                  (unsigned long long)counters.threadingNum);
+    std::string json = buffer;
+
+    for(int i = 0; i < PHASE_NUM; ++i){
+        std::snprintf(buffer, sizeof(buffer), "%s\"%s\":%llu", i ? "," : "",
+                      phaseName(PHASE(i)), (unsigned long long)phaseNanoseconds[i]);
+        json += buffer;
+    }
+    json += "},\"levels\":[";
+    for(std::size_t i = 0; i < levels.size(); ++i){
+        std::snprintf(buffer, sizeof(buffer), "%s{\"width\":%llu,\"nanoseconds\":%llu}", i ? "," : "",
+                      (unsigned long long)levels[i].width, (unsigned long long)levels[i].nanoseconds);
+        json += buffer;
+    }
+    json += "]}";
+    return json;
+}
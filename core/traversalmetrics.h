@@ -0,0 +1,113 @@
+#ifndef TRAVERSALMETRICS_H
+#define TRAVERSALMETRICS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * 遍历的统计信息
+ * treeTraversal以统计策略（Stats）为模板参数，在压栈、出栈、沿线索前进等位置调用其钩子。
+ * 默认的noTraversalStats钩子全为空且enabled为false，编译后不留任何代码；
+ * 需要统计时换用traversalCounters，由调用方决定是否实例化带统计的版本。
+ */
+
+// 不统计
+struct noTraversalStats
+{
+    static const bool enabled = false;
+
+    void visit() {}
+    void push(std::size_t) {}
+    void pop() {}
+    void nullSentinel() {}
+    void followThread() {}
+    void threading() {}
+};
+
+
+// 统计各项计数（多次遍历累加，reset()清零）
+struct traversalCounters
+{
+    static const bool enabled = true;
+
+    std::uint64_t visitedNum = 0;           // 访问的结点数
+    std::uint64_t pushNum = 0;              // 压栈次数
+    std::uint64_t popNum = 0;               // 出栈次数
+    std::uint64_t peakStackDepth = 0;       // 栈的最大深度
+    std::uint64_t nullSentinelNum = 0;      // 压入的空指针数
+    std::uint64_t threadFollowedNum = 0;    // 沿线索前进的次数
+    std::uint64_t threadingNum = 0;         // threading()的调用次数
+
+    void visit() { ++visitedNum; }
+    void push(std::size_t depth)
+    {
+        ++pushNum;
+        if(depth > peakStackDepth)
+            peakStackDepth = depth;
+    }
+    void pop() { ++popNum; }
+    void nullSentinel() { ++nullSentinelNum; }
+    void followThread() { ++threadFollowedNum; }
+    void threading() { ++threadingNum; }
+
+    void reset() { *this = traversalCounters(); }
+};
+
+
+// 一次完整操作（可含多个阶段）的统计信息
+struct traversalMetrics
+{
+    // 阶段
+    enum PHASE { THREADING_PHASE, TRAVERSAL_PHASE, CLEAR_THREAD_PHASE, COUNT_LEAF_PHASE, PHASE_NUM };
+
+    // 层序遍历中一层的宽度与累计耗时
+    struct levelTiming
+    {
+        std::uint64_t width;
+        std::uint64_t nanoseconds;
+    };
+
+    traversalCounters counters;
+    std::uint64_t phaseNanoseconds[PHASE_NUM] = {};     // 各阶段累计的墙钟时间
+    std::vector<levelTiming> levels;                    // 第i项为深度为i的层（只有层序遍历记录）
+
+    static const char* phaseName(PHASE phase);
+
+    // 累加深度为depth的层的耗时
+    void addLevel(std::size_t depth, std::size_t width, std::uint64_t nanoseconds);
+
+    // 导出为JSON对象
+    std::string toJson() const;
+};
+
+
+// 在作用域内计时，结束时累加到对应阶段
+class scopedPhaseTimer
+{
+public:
+    scopedPhaseTimer(traversalMetrics& _metrics, traversalMetrics::PHASE _phase):
+        metrics(_metrics),
+        phase(_phase),
+        start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~scopedPhaseTimer()
+    {
+        metrics.phaseNanoseconds[phase] += std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                             std::chrono::steady_clock::now() - start).count());
+    }
+
+    scopedPhaseTimer(const scopedPhaseTimer&) = delete;
+    scopedPhaseTimer& operator=(const scopedPhaseTimer&) = delete;
+
+private:
+    traversalMetrics& metrics;
+    traversalMetrics::PHASE phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // TRAVERSALMETRICS_H
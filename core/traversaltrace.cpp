@@ -0,0 +1,93 @@
+#include "traversaltrace.h"
+#include <algorithm>
+
+/**
+ * @brief traversalTrace::clear 清空轨迹
+ * @param _nodeNum 结点数，决定奇偶性位图的大小与检查点间隔
+ */
+void traversalTrace::clear(std::size_t _nodeNum)
+{
+    nodeNum = _nodeNum;
+    wordNum = (nodeNum + 63) / 64;
+
+    // 每个检查点占wordNum*8字节，间隔不小于其一半的事件数（每个事件4字节），检查点的总内存不超过事件本身；
+    // 在此前提下间隔尽量小，但不小于log2(结点数)，跳转时补算的事件数为O(log n + n/64)
+    std::size_t logNodeNum = 0;
+    for(std::size_t n = nodeNum; n; n >>= 1)
+        ++logNodeNum;
+    interval = 1;
+    while(interval < logNodeNum || interval < wordNum * 2)
+        interval *= 2;
+
+    events.clear();
+    threadPositions.clear();
+    threadTargets.clear();
+    markerPositions.clear();
+    current.assign(wordNum, 0);
+    checkpoints.clear();
+}
+
+void traversalTrace::append(EVENT kind, index_type value)
+{
+    // 到达检查点位置时保存当前的奇偶性
+    if(events.size() % interval == 0)
+        checkpoints.insert(checkpoints.end(), current.begin(), current.end());
+    events.push_back(std::uint32_t(kind) << 30 | value);
+}
+
+void traversalTrace::addVisit(index_type node)
+{
+    append(VISIT, node);
+    current[node >> 6] ^= std::uint64_t(1) << (node & 63);
+}
+
+void traversalTrace::addThread(index_type node, index_type target, bool isLeft)
+{
+    threadPositions.push_back(events.size());
+    threadTargets.push_back(target);
+    append(isLeft ? LEFT_THREAD : RIGHT_THREAD, node);
+}
+
+void traversalTrace::addMarker(index_type value)
+{
+    markerPositions.push_back(events.size());
+    append(MARKER, value);
+}
+
+std::size_t traversalTrace::threadNumBefore(std::size_t position) const
+{
+    return std::size_t(std::lower_bound(threadPositions.begin(), threadPositions.end(), position) - threadPositions.begin());
+}
+
+bool traversalTrace::lastMarkerBefore(std::size_t position, index_type& value) const
+{
+    std::vector<std::size_t>::const_iterator it = std::lower_bound(markerPositions.begin(), markerPositions.end(), position);
+    if(it == markerPositions.begin())
+        return false;
+    value = getValue(*--it);
+    return true;
+}
+
+/**
+ * @brief traversalTrace::parityBefore 求前position个事件生效后各结点访问次数的奇偶性
+ * @param position 位置（不超过size()）
+ * @param parity 输出的位图
+ */
+void traversalTrace::parityBefore(std::size_t position, std::vector<std::uint64_t>& parity) const
+{
+    if(position > events.size())
+        position = events.size();
+
+    std::size_t k = position / interval;
+    if(k * wordNum >= checkpoints.size()){     // 恰在最后一个检查点之后（尚未记录该检查点）
+        parity = current;
+        return;
+    }
+    parity.assign(checkpoints.begin() + std::ptrdiff_t(k * wordNum), checkpoints.begin() + std::ptrdiff_t((k + 1) * wordNum));
+    for(std::size_t i = k * interval; i < position; ++i){
+        if(getKind(i) == VISIT){
+            index_type node = getValue(i);
+            parity[node >> 6] ^= std::uint64_t(1) << (node & 63);
+        }
+    }
+}
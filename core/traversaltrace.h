@@ -0,0 +1,76 @@
+#ifndef TRAVERSALTRACE_H
+#define TRAVERSALTRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * 遍历的轨迹：遍历全速执行一次，按顺序记录访问结点、建立线索与阶段标记等事件，之后可反复回放与跳转
+ * 每个事件占一个uint32（高2位为类型，低30位为结点编号或标记值），线索的终点另存，
+ * 因此结点编号不超过2^30。
+ *
+ * 第position个事件之前的状态（前position个事件生效后）：
+ *   各结点被访问次数的奇偶性  复制最近的检查点（n/64个字，恢复全部结点的颜色本就需要这么多）后补算，
+ *                             检查点间隔为max(log2 n, n/32)向上取整到2的幂，补算O(log n + n/64)个事件，
+ *                             检查点的总内存不超过事件本身
+ *   已建立的线索数、最近的标记  在有序的位置表中二分查找
+ */
+class traversalTrace
+{
+public:
+    typedef std::uint32_t index_type;
+    enum EVENT { VISIT, LEFT_THREAD, RIGHT_THREAD, MARKER };
+    static const index_type maxValue = (index_type(1) << 30) - 1;
+
+    // 清空并指定结点数（编号须小于nodeNum）
+    void clear(std::size_t nodeNum);
+
+    // 记录
+    void addVisit(index_type node);
+    void addThread(index_type node, index_type target, bool isLeft);
+    void addMarker(index_type value);   // 阶段标记，含义由调用方解释
+
+    // 事件
+    std::size_t size() const { return events.size(); }
+    bool empty() const { return events.empty(); }
+    EVENT getKind(std::size_t i) const { return EVENT(events[i] >> 30); }
+    index_type getValue(std::size_t i) const { return events[i] & maxValue; }     // 结点编号或标记值
+
+    // 检查点间隔（由clear按结点数确定）
+    std::size_t getCheckpointInterval() const { return interval; }
+
+    // 第rank条线索
+    std::size_t getThreadNum() const { return threadPositions.size(); }
+    index_type getThreadTarget(std::size_t rank) const { return threadTargets[rank]; }
+    std::size_t getThreadPosition(std::size_t rank) const { return threadPositions[rank]; }
+
+    // position之前已建立的线索数，O(log n)
+    std::size_t threadNumBefore(std::size_t position) const;
+
+    // position之前最近的标记，没有则返回false，O(log n)
+    bool lastMarkerBefore(std::size_t position, index_type& value) const;
+
+    /**
+     * position之前各结点访问次数的奇偶性（按位存放，第i位对应结点i）
+     * 从检查点出发，至多补算一个检查点间隔的事件，O(log n + n/64)
+     */
+    void parityBefore(std::size_t position, std::vector<std::uint64_t>& parity) const;
+
+private:
+    std::size_t nodeNum = 0;
+    std::size_t wordNum = 0;            // 奇偶性位图的字数
+    std::size_t interval = 1;           // 检查点间隔（2的幂）
+
+    std::vector<std::uint32_t> events;
+    std::vector<std::size_t> threadPositions;
+    std::vector<index_type> threadTargets;
+    std::vector<std::size_t> markerPositions;
+
+    std::vector<std::uint64_t> current;         // 记录过程中的奇偶性
+    std::vector<std::uint64_t> checkpoints;     // 第k个检查点为第k*interval个事件之前的奇偶性，依次存放
+
+    void append(EVENT kind, index_type value);
+};
+
+#endif // TRAVERSALTRACE_H
@@ -0,0 +1,281 @@
+#ifndef TREEITERATOR_H
+#define TREEITERATOR_H
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <vector>
+#include "binarytreenode.h"
+#include "traversal.h"
+
+/*
+ * 惰性遍历迭代器
+ * 每次++只前进到下一个结点，可随时停止，可直接交给标准库算法使用
+ * 栈式迭代器只沿LINK走，线索化后的树同样适用；线索迭代器不需要栈，要求树已按对应顺序线索化
+ */
+
+// 遍历迭代器的公共部分
+template<class Access>
+class treeIteratorBase
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename Access::node_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type* pointer;
+    typedef const value_type& reference;
+
+    reference operator*() const { return cur; }
+    pointer operator->() const { return &cur; }
+    bool operator==(const treeIteratorBase& other) const { return cur == other.cur; }
+    bool operator!=(const treeIteratorBase& other) const { return cur != other.cur; }
+
+protected:
+    Access access;
+    value_type cur;     // 当前结点，遍历结束时为空
+
+    explicit treeIteratorBase(const Access& _access):
+        access(_access),
+        cur(_access.null())
+    {
+    }
+
+    value_type linkedLeft(value_type n) const { return access.leftTag(n) == binaryTreeNode::LINK ? access.left(n) : access.null(); }
+    value_type linkedRight(value_type n) const { return access.rightTag(n) == binaryTreeNode::LINK ? access.right(n) : access.null(); }
+};
+
+
+// 栈式遍历迭代器
+template<class Order, class Access>
+class traversalIterator;
+
+template<class Access>
+class traversalIterator<preOrder, Access>: public treeIteratorBase<Access>
+{
+    typedef treeIteratorBase<Access> base;
+    typedef typename base::value_type node_type;
+    std::vector<node_type> s;   // 待访问的右子树
+
+public:
+    explicit traversalIterator(const Access& _access = Access(), node_type root = Access().null()):
+        base(_access)
+    {
+        this->cur = root;
+    }
+
+    traversalIterator& operator++()
+    {
+        node_type l = this->linkedLeft(this->cur), r = this->linkedRight(this->cur);
+        if(r != this->access.null())
+            s.push_back(r);
+        if(l != this->access.null())
+            this->cur = l;
+        else if(!s.empty()){
+            this->cur = s.back();
+            s.pop_back();
+        }
+        else
+            this->cur = this->access.null();
+        return *this;
+    }
+
+    traversalIterator operator++(int) { traversalIterator old = *this; ++*this; return old; }
+};
+
+template<class Access>
+class traversalIterator<inOrder, Access>: public treeIteratorBase<Access>
+{
+    typedef treeIteratorBase<Access> base;
+    typedef typename base::value_type node_type;
+    std::vector<node_type> s;   // 左链上尚未访问的祖先
+
+    void pushLeftPath(node_type n)
+    {
+        for(; n != this->access.null(); n = this->linkedLeft(n))
+            s.push_back(n);
+        if(s.empty())
+            this->cur = this->access.null();
+        else{
+            this->cur = s.back();
+            s.pop_back();
+        }
+    }
+
+public:
+    explicit traversalIterator(const Access& _access = Access(), node_type root = Access().null()):
+        base(_access)
+    {
+        pushLeftPath(root);
+    }
+
+    traversalIterator& operator++()
+    {
+        pushLeftPath(this->linkedRight(this->cur));
+        return *this;
+    }
+
+    traversalIterator operator++(int) { traversalIterator old = *this; ++*this; return old; }
+};
+
+template<class Access>
+class traversalIterator<postOrder, Access>: public treeIteratorBase<Access>
+{
+    typedef treeIteratorBase<Access> base;
+    typedef typename base::value_type node_type;
+    std::vector<node_type> s;   // 从根到当前结点的路径（不含当前结点）
+
+    // 从n出发尽量向左、其次向右下降到叶子
+    void descend(node_type n)
+    {
+        node_type c;
+        while(true){
+            if((c = this->linkedLeft(n)) == this->access.null() && (c = this->linkedRight(n)) == this->access.null())
+                break;
+            s.push_back(n);
+            n = c;
+        }
+        this->cur = n;
+    }
+
+public:
+    explicit traversalIterator(const Access& _access = Access(), node_type root = Access().null()):
+        base(_access)
+    {
+        if(root != this->access.null())
+            descend(root);
+    }
+
+    traversalIterator& operator++()
+    {
+        if(s.empty()){
+            this->cur = this->access.null();
+            return *this;
+        }
+        node_type parent = s.back(), r = this->linkedRight(parent);
+        if(this->cur != r && r != this->access.null())
+            descend(r);     // 左子树访问完，进入右子树
+        else{
+            s.pop_back();
+            this->cur = parent;
+        }
+        return *this;
+    }
+
+    traversalIterator operator++(int) { traversalIterator old = *this; ++*this; return old; }
+};
+
+template<class Access>
+class traversalIterator<levelOrder, Access>: public treeIteratorBase<Access>
+{
+    typedef treeIteratorBase<Access> base;
+    typedef typename base::value_type node_type;
+    std::deque<node_type> q;    // 下一层待访问的结点
+
+public:
+    explicit traversalIterator(const Access& _access = Access(), node_type root = Access().null()):
+        base(_access)
+    {
+        this->cur = root;
+    }
+
+    traversalIterator& operator++()
+    {
+        node_type l = this->linkedLeft(this->cur), r = this->linkedRight(this->cur);
+        if(l != this->access.null())
+            q.push_back(l);
+        if(r != this->access.null())
+            q.push_back(r);
+        if(q.empty())
+            this->cur = this->access.null();
+        else{
+            this->cur = q.front();
+            q.pop_front();
+        }
+        return *this;
+    }
+
+    traversalIterator operator++(int) { traversalIterator old = *this; ++*this; return old; }
+};
+
+
+// 线索二叉树的后继迭代器，O(1)额外空间
+template<class Order, class Access>
+class threadedIterator: public treeIteratorBase<Access>
+{
+    typedef treeIteratorBase<Access> base;
+    typedef typename base::value_type node_type;
+
+    node_type first(preOrder, node_type root) const { return root; }
+
+    node_type first(inOrder, node_type n) const
+    {
+        if(n != this->access.null())
+            while(this->access.leftTag(n) == binaryTreeNode::LINK && this->access.left(n) != this->access.null())
+                n = this->access.left(n);
+        return n;
+    }
+
+    node_type first(postOrder, node_type n) const
+    {
+        node_type c;
+        if(n != this->access.null())
+            while((c = this->linkedLeft(n)) != this->access.null() || (c = this->linkedRight(n)) != this->access.null())
+                n = c;
+        return n;
+    }
+
+    node_type next(preOrder, node_type p) const
+    {
+        return this->access.leftTag(p) == binaryTreeNode::LINK && this->access.left(p) != this->access.null() ? this->access.left(p) : this->access.right(p);
+    }
+
+    node_type next(inOrder, node_type p) const
+    {
+        if(this->access.rightTag(p) == binaryTreeNode::THREAD)
+            return this->access.right(p);
+        return first(inOrder(), this->access.right(p));
+    }
+
+    node_type next(postOrder, node_type p) const
+    {
+        node_type q;
+        if(this->access.rightTag(p) == binaryTreeNode::THREAD)
+            return this->access.right(p);
+        if((q = this->access.parent(p)) == this->access.null())
+            return q;
+        if(this->linkedRight(q) == p || this->linkedRight(q) == this->access.null())
+            return q;
+        return first(postOrder(), this->linkedRight(q));
+    }
+
+public:
+    explicit threadedIterator(const Access& _access = Access(), node_type root = Access().null()):
+        base(_access)
+    {
+        this->cur = first(Order(), root);
+    }
+
+    threadedIterator& operator++()
+    {
+        this->cur = next(Order(), this->cur);
+        return *this;
+    }
+
+    threadedIterator operator++(int) { threadedIterator old = *this; ++*this; return old; }
+};
+
+
+// 遍历区间，可用于范围for与标准库算法
+template<class Iterator>
+class traversalRange
+{
+    Iterator first, last;
+
+public:
+    traversalRange(Iterator _first, Iterator _last): first(_first), last(_last) {}
+
+    Iterator begin() const { return first; }
+    Iterator end() const { return last; }
+};
+
+#endif // TREEITERATOR_H
@@ -0,0 +1,246 @@
+#include "treeparser.h"
+#include <cstring>
+#include <fstream>
+
+// 分隔符：空白、逗号与方括号
+static inline bool isSeparator(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',' || c == '[' || c == ']';
+}
+
+// 空结点标记
+static inline bool isNullMarker(const char* token, std::size_t length)
+{
+    switch(length){
+        case 1: return token[0] == '#';
+        case 3: return std::memcmp(token, "nil", 3) == 0;
+        case 4: return std::memcmp(token, "null", 4) == 0 || std::memcmp(token, "None", 4) == 0;
+        default: return false;
+    }
+}
+
+treeParser::treeParser(FORMAT _format):
+    format(_format)
+{
+}
+
+void treeParser::setNodeCallback(nodeCallback callback)
+{
+    onNode = callback;
+}
+
+void treeParser::setProgressCallback(progressCallback callback)
+{
+    onProgress = callback;
+}
+
+void treeParser::setChunkSize(std::size_t bytes)
+{
+    chunkSize = bytes ? bytes : 1;
+}
+
+const std::string& treeParser::getError() const
+{
+    return error;
+}
+
+/**
+ * @brief treeParser::parseFile 解析文本文件
+ * @param path 文件路径
+ * @param tree 解析结果
+ * @return 是否成功
+ */
+bool treeParser::parseFile(const std::string& path, arrayTree& tree)
+{
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if(!in){
+        error = "cannot open " + path;
+        return false;
+    }
+    return parse(in, tree);
+}
+
+/**
+ * @brief treeParser::parse 按块读取并单趟解析
+ * @param in 输入流
+ * @param tree 解析结果
+ * @return 是否成功
+ */
+bool treeParser::parse(std::istream& in, arrayTree& _tree)
+{
+    tree = &_tree;
+    tree->clear();
+    stack.clear();
+    nextParent = 0;
+    nextIsLeft = true;
+    started = finished = false;
+    tokenNum = 0;
+    error.clear();
+
+    std::vector<char> buffer(chunkSize);
+    std::string carry;      // 跨块的半个token
+    std::uint64_t bytesRead = 0;
+
+    while(in){
+        in.read(buffer.data(), std::streamsize(buffer.size()));
+        std::size_t n = std::size_t(in.gcount());
+        if(n == 0)
+            break;
+        bytesRead += n;
+
+        const char* p = buffer.data(), * end = p + n;
+        while(p < end){
+            if(isSeparator(*p)){
+                if(!carry.empty()){
+                    if(!handleToken(carry.data(), carry.size()))
+                        return false;
+                    carry.clear();
+                }
+                ++p;
+                continue;
+            }
+            const char* begin = p;
+            while(p < end && !isSeparator(*p))
+                ++p;
+            if(p == end)
+                carry.append(begin, p);     // token可能延续到下一块
+            else if(!carry.empty()){
+                carry.append(begin, p);
+                if(!handleToken(carry.data(), carry.size()))
+                    return false;
+                carry.clear();
+            }
+            else if(!handleToken(begin, std::size_t(p - begin)))
+                return false;
+        }
+
+        if(onProgress)
+            onProgress(bytesRead);
+    }
+
+    // 读取出错与读到末尾同样会结束循环，须区分，否则会把截断的输入当作完整的树
+    if(in.bad())
+        return fail("read error after " + std::to_string(bytesRead) + " bytes");
+
+    if(!carry.empty() && !handleToken(carry.data(), carry.size()))
+        return false;
+
+    if(format == PREORDER_NULL_MARKER && started && !finished)
+        return fail("unexpected end of input: the preorder sequence is incomplete");
+    return true;
+}
+
+/**
+ * @brief treeParser::handleToken 处理一个token
+ * @return 是否成功
+ */
+bool treeParser::handleToken(const char* token, std::size_t length)
+{
+    ++tokenNum;
+    bool isNull = isNullMarker(token, length);
+    if(format == PREORDER_NULL_MARKER)
+        return handlePreOrder(isNull, token, length);
+    return handleLevelOrder(isNull, token, length);
+}
+
+/**
+ * @brief treeParser::handlePreOrder 前序：栈顶结点依次接收左、右孩子
+ */
+bool treeParser::handlePreOrder(bool isNull, const char* token, std::size_t length)
+{
+    if(finished)
+        return fail("unexpected token after the end of the preorder sequence (token " + std::to_string(tokenNum) + ")");
+
+    if(!started){
+        started = true;
+        if(isNull)
+            finished = true;    // 空树
+        else{
+            arrayTree::index_type root;
+            if(!newNode(token, length, root))
+                return false;
+            stack.push_back(pendingNode{root, false});
+        }
+        return true;
+    }
+
+    pendingNode& top = stack.back();
+    arrayTree::index_type parent = top.node;
+    bool isLeft = !top.leftDone;
+    if(isLeft)
+        top.leftDone = true;
+    else
+        stack.pop_back();   // 右孩子处理后，该结点不再等待
+
+    if(!isNull){
+        arrayTree::index_type child;
+        if(!newNode(token, length, child))
+            return false;
+        if(isLeft)
+            tree->setLeftChild(parent, child, binaryTreeNode::LINK);
+        else
+            tree->setRightChild(parent, child, binaryTreeNode::LINK);
+        tree->setParentNode(child, parent);
+        stack.push_back(pendingNode{child, false});
+    }
+
+    if(stack.empty())
+        finished = true;
+    return true;
+}
+
+/**
+ * @brief treeParser::handleLevelOrder 层序：非空结点按出现顺序编号，依次接收左、右孩子
+ */
+bool treeParser::handleLevelOrder(bool isNull, const char* token, std::size_t length)
+{
+    if(!started){
+        started = true;
+        arrayTree::index_type root;
+        return isNull || newNode(token, length, root);
+    }
+
+    if(nextParent >= tree->size()){
+        if(isNull)
+            return true;    // 末尾多余的空标记
+        return fail("node without a parent at token " + std::to_string(tokenNum));
+    }
+
+    if(!isNull){
+        arrayTree::index_type child;
+        if(!newNode(token, length, child))
+            return false;
+        if(nextIsLeft)
+            tree->setLeftChild(nextParent, child, binaryTreeNode::LINK);
+        else
+            tree->setRightChild(nextParent, child, binaryTreeNode::LINK);
+        tree->setParentNode(child, nextParent);
+    }
+
+    if(!nextIsLeft)
+        ++nextParent;
+    nextIsLeft = !nextIsLeft;
+    return true;
+}
+
+/**
+ * @brief treeParser::newNode 新建结点并回调
+ * @param node 新结点的下标
+ * @return 是否成功（结点数不能超过arrayTree::maxNodeNum，否则下标与空结点重合）
+ */
+bool treeParser::newNode(const char* token, std::size_t length, arrayTree::index_type& node)
+{
+    node = tree->addNode();
+    if(node == arrayTree::nil)
+        return fail("too many nodes: at most " + std::to_string(arrayTree::maxNodeNum)
+                    + " nodes are supported (token " + std::to_string(tokenNum) + ")");
+    if(onNode)
+        onNode(node, token, length);
+    return true;
+}
+
+bool treeParser::fail(const std::string& message)
+{
+    error = message;
+    return false;
+}
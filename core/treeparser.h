@@ -0,0 +1,70 @@
+#ifndef TREEPARSER_H
+#define TREEPARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+#include "arraytree.h"
+
+/*
+ * 流式的二叉树文本解析
+ * 支持两种格式：
+ *   PREORDER_NULL_MARKER 带空标记的前序序列，如 "1 2 # # 3 # #"
+ *   LEVEL_ORDER_ARRAY    层序数组，如 "[1,2,null,3]"
+ * 逗号、方括号与空白均视为分隔符，空标记可为 null / # / None / nil。
+ * 按块读取，单趟线性解析；除树本身外，前序只需O(树高)的栈，层序只需O(1)的额外空间。
+ */
+class treeParser
+{
+public:
+    enum FORMAT { PREORDER_NULL_MARKER, LEVEL_ORDER_ARRAY };
+
+    // 每建立一个结点回调一次，token为该结点的文本（如需保存结点名称）
+    typedef std::function<void(arrayTree::index_type node, const char* token, std::size_t length)> nodeCallback;
+    // 每读完一块回调一次，参数为已读取的字节数
+    typedef std::function<void(std::uint64_t bytesRead)> progressCallback;
+
+    explicit treeParser(FORMAT _format);
+
+    void setNodeCallback(nodeCallback callback);
+    void setProgressCallback(progressCallback callback);
+    void setChunkSize(std::size_t bytes);
+
+    // 解析到tree中（tree会先被清空），失败时返回false，可用getError获取原因
+    bool parse(std::istream& in, arrayTree& tree);
+    bool parseFile(const std::string& path, arrayTree& tree);
+    const std::string& getError() const;
+
+private:
+    // 前序解析时等待孩子的结点
+    struct pendingNode
+    {
+        arrayTree::index_type node;
+        bool leftDone;
+    };
+
+    FORMAT format;
+    nodeCallback onNode;
+    progressCallback onProgress;
+    std::size_t chunkSize = 1 << 20;
+    std::string error;
+
+    // 解析状态
+    arrayTree* tree = nullptr;
+    std::vector<pendingNode> stack;         // 前序
+    arrayTree::index_type nextParent = 0;   // 层序：下一个等待孩子的结点（层序编号即下标）
+    bool nextIsLeft = true;
+    bool started = false, finished = false;
+    std::uint64_t tokenNum = 0;
+
+    bool handleToken(const char* token, std::size_t length);
+    bool handlePreOrder(bool isNull, const char* token, std::size_t length);
+    bool handleLevelOrder(bool isNull, const char* token, std::size_t length);
+    bool newNode(const char* token, std::size_t length, arrayTree::index_type& node);
+    bool fail(const std::string& message);
+};
+
+#endif // TREEPARSER_H
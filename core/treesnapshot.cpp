@@ -0,0 +1,410 @@
+#include "treesnapshot.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace treeSnapshotFormat;
+
+static std::uint64_t alignUp(std::uint64_t n)
+{
+    return (n + alignment - 1) / alignment * alignment;
+}
+
+// 带缓冲的顺序写出，记录当前位置以便各段对齐
+class sequentialWriter
+{
+public:
+    explicit sequentialWriter(std::ofstream& _out): out(_out) { buffer.reserve(capacity); }
+
+    void write(const void* data, std::size_t bytes)
+    {
+        const char* p = static_cast<const char*>(data);
+        position += bytes;
+        if(buffer.size() + bytes > capacity)
+            flush();
+        if(bytes >= capacity)
+            out.write(p, std::streamsize(bytes));
+        else
+            buffer.insert(buffer.end(), p, p + bytes);
+    }
+
+    // 补零到对齐位置，返回新段的起始位置
+    std::uint64_t align()
+    {
+        static const char zeros[alignment] = {};
+        write(zeros, std::size_t(alignUp(position) - position));
+        return position;
+    }
+
+    void flush()
+    {
+        out.write(buffer.data(), std::streamsize(buffer.size()));
+        buffer.clear();
+    }
+
+    std::uint64_t tell() const { return position; }
+
+private:
+    static const std::size_t capacity = 1 << 20;
+    std::ofstream& out;
+    std::vector<char> buffer;
+    std::uint64_t position = 0;
+};
+
+
+void snapshotWriter::setLayout(const float* _x, const float* _y)
+{
+    x = _x;
+    y = _y;
+}
+
+void snapshotWriter::setNameProvider(nameProvider provider)
+{
+    names = provider;
+}
+
+const std::string& snapshotWriter::getError() const
+{
+    return error;
+}
+
+/**
+ * @brief snapshotWriter::save 按段顺序写出快照，最后回填文件头
+ * @param tree 要保存的树
+ * @param path 文件路径
+ * @return 是否成功
+ */
+bool snapshotWriter::save(const arrayTree& tree, const std::string& path)
+{
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    if(!out){
+        error = "cannot create " + path;
+        return false;
+    }
+
+    const std::size_t n = tree.size();
+    const std::size_t wordNum = (n + 63) / 64;
+    header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, magic, sizeof(h.magic));
+    h.version = version;
+    h.byteOrder = byteOrderMark;
+    h.nodeNum = n;
+    h.root = tree.getRoot();
+
+    sequentialWriter writer(out);
+    writer.write(&h, sizeof(h));    // 占位，末尾回填
+
+    // 下标数组
+    const std::size_t block = 1 << 14;
+    std::vector<index_type> indices(block);
+    for(int s = LEFT_CHILD; s <= PARENT_NODE; ++s){
+        h.offset[s] = writer.align();
+        for(std::size_t i = 0; i < n; i += block){
+            std::size_t m = std::min(block, n - i);
+            for(std::size_t k = 0; k < m; ++k){
+                index_type node = index_type(i + k);
+                indices[k] = s == LEFT_CHILD ? tree.getLeftChild(node)
+                           : s == RIGHT_CHILD ? tree.getRightChild(node) : tree.getParentNode(node);
+            }
+            writer.write(indices.data(), m * sizeof(index_type));
+        }
+        h.size[s] = writer.tell() - h.offset[s];
+    }
+
+    // 标记位图
+    for(int s = LEFT_TAG; s <= RIGHT_TAG; ++s){
+        h.offset[s] = writer.align();
+        for(std::size_t w = 0; w < wordNum; ++w){
+            std::uint64_t word = 0;
+            for(std::size_t b = 0, i = w * 64; b < 64 && i < n; ++b, ++i){
+                index_type node = index_type(i);
+                binaryTreeNode::TAG tag = s == LEFT_TAG ? tree.getLeftChildTag(node) : tree.getRightChildTag(node);
+                if(tag == binaryTreeNode::THREAD)
+                    word |= std::uint64_t(1) << b;
+            }
+            writer.write(&word, sizeof(word));
+        }
+        h.size[s] = writer.tell() - h.offset[s];
+    }
+
+    // 布局坐标
+    if(x && y){
+        h.offset[LAYOUT_X] = writer.align();
+        writer.write(x, n * sizeof(float));
+        h.size[LAYOUT_X] = n * sizeof(float);
+        h.offset[LAYOUT_Y] = writer.align();
+        writer.write(y, n * sizeof(float));
+        h.size[LAYOUT_Y] = n * sizeof(float);
+    }
+
+    // 名称：先写数据，同时记录偏移，再写偏移表
+    if(names){
+        std::vector<std::uint64_t> offsets;
+        offsets.reserve(n + 1);
+        h.offset[NAME_DATA] = writer.align();
+        std::uint64_t dataSize = 0;
+        for(std::size_t i = 0; i < n; ++i){
+            offsets.push_back(dataSize);
+            std::string name = names(index_type(i));
+            writer.write(name.data(), name.size());
+            dataSize += name.size();
+        }
+        offsets.push_back(dataSize);
+        h.size[NAME_DATA] = dataSize;
+        h.offset[NAME_OFFSET] = writer.align();
+        writer.write(offsets.data(), offsets.size() * sizeof(std::uint64_t));
+        h.size[NAME_OFFSET] = offsets.size() * sizeof(std::uint64_t);
+    }
+
+    writer.align();
+    writer.flush();
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.flush();
+    if(!out){
+        error = "failed to write " + path;
+        return false;
+    }
+    return true;
+}
+
+
+const mappedTree::index_type mappedTree::nil;
+
+mappedTree::mappedTree():
+    algorithm(mappedTreeAccess(this))
+{
+}
+
+mappedTree::~mappedTree()
+{
+    close();
+}
+
+bool mappedTree::isOpen() const
+{
+    return base != nullptr;
+}
+
+const std::string& mappedTree::getError() const
+{
+    return error;
+}
+
+/**
+ * @brief mappedTree::open 映射快照文件并校验文件头，不读取结点数据
+ * @param path 文件路径
+ * @return 是否成功
+ */
+bool mappedTree::open(const std::string& path)
+{
+    close();
+    error.clear();
+    if(!map(path))
+        return false;
+
+    if(length < sizeof(header))
+        return fail("file is too small to be a snapshot");
+    header h;
+    std::memcpy(&h, base, sizeof(h));
+    if(std::memcmp(h.magic, magic, sizeof(h.magic)) != 0)
+        return fail("not a tree snapshot");
+    if(h.byteOrder != byteOrderMark)
+        return fail("snapshot was written with a different byte order");
+    if(h.version != version)
+        return fail("unsupported snapshot version " + std::to_string(h.version));
+    if(h.nodeNum > nil)
+        return fail("node count exceeds the 32-bit index range");
+
+    const std::uint64_t n = h.nodeNum;
+    const std::uint64_t expected[SECTION_NUM] = {
+        n * sizeof(index_type), n * sizeof(index_type), n * sizeof(index_type),
+        (n + 63) / 64 * sizeof(std::uint64_t), (n + 63) / 64 * sizeof(std::uint64_t),
+        n * sizeof(float), n * sizeof(float), h.size[NAME_DATA], (n + 1) * sizeof(std::uint64_t)
+    };
+    for(int s = 0; s < SECTION_NUM; ++s){
+        bool optional = s >= LAYOUT_X;
+        if(h.offset[s] == 0){
+            if(!optional)
+                return fail("missing required section " + std::to_string(s));
+            continue;
+        }
+        if(h.offset[s] % alignment != 0 || h.size[s] != expected[s]
+                || h.offset[s] > length || h.size[s] > length - h.offset[s])
+            return fail("corrupted section " + std::to_string(s));
+    }
+    if((h.offset[LAYOUT_X] == 0) != (h.offset[LAYOUT_Y] == 0)
+            || (h.offset[NAME_DATA] == 0) != (h.offset[NAME_OFFSET] == 0))
+        return fail("incomplete optional section");
+    if(n ? h.root >= n : h.root != nil)
+        return fail("invalid root");
+
+    nodeNum = std::size_t(n);
+    root = h.root;
+    leftChild = reinterpret_cast<index_type*>(base + h.offset[LEFT_CHILD]);
+    rightChild = reinterpret_cast<index_type*>(base + h.offset[RIGHT_CHILD]);
+    parentNode = reinterpret_cast<index_type*>(base + h.offset[PARENT_NODE]);
+    leftTag = reinterpret_cast<std::uint64_t*>(base + h.offset[LEFT_TAG]);
+    rightTag = reinterpret_cast<std::uint64_t*>(base + h.offset[RIGHT_TAG]);
+    if(h.offset[LAYOUT_X]){
+        layoutX = reinterpret_cast<const float*>(base + h.offset[LAYOUT_X]);
+        layoutY = reinterpret_cast<const float*>(base + h.offset[LAYOUT_Y]);
+    }
+    if(h.offset[NAME_DATA]){
+        nameData = base + h.offset[NAME_DATA];
+        nameOffset = reinterpret_cast<const std::uint64_t*>(base + h.offset[NAME_OFFSET]);
+        if(nameOffset[n] != h.size[NAME_DATA])
+            return fail("corrupted name offsets");
+    }
+    return true;
+}
+
+/**
+ * @brief mappedTree::verify 检查所有下标与名称偏移，并检查从根可达的部分是一棵树，保证后续访问不会越界或陷入环
+ * 每个LINK孩子c都要求parentNode[c]为它的双亲、且左右LINK孩子不同，于是每个结点至多被一条LINK指向；
+ * 再要求根没有双亲，从根沿LINK可达的部分就不会有环或共享的子树，栈式遍历与清除线索必然结束。
+ * 线索只检查下标范围，不检查是否符合某种次序，不可信的文件应先清除线索再重新线索化后才做线索遍历。
+ * @return 是否合法
+ */
+bool mappedTree::verify()
+{
+    if(!isOpen())
+        return fail("no snapshot is open");
+    if(root != nil && parentNode[root] != nil)
+        return fail("root has a parent");
+    for(std::size_t i = 0; i < nodeNum; ++i){
+        if((leftChild[i] != nil && leftChild[i] >= nodeNum)
+                || (rightChild[i] != nil && rightChild[i] >= nodeNum)
+                || (parentNode[i] != nil && parentNode[i] >= nodeNum))
+            return fail("index out of range at node " + std::to_string(i));
+        index_type n = index_type(i);
+        index_type left = getLeftChildTag(n) == binaryTreeNode::LINK ? leftChild[i] : nil;
+        index_type right = getRightChildTag(n) == binaryTreeNode::LINK ? rightChild[i] : nil;
+        if((left != nil && parentNode[left] != n) || (right != nil && parentNode[right] != n))
+            return fail("child does not point back to its parent at node " + std::to_string(i));
+        if(left != nil && left == right)
+            return fail("both children are the same node at node " + std::to_string(i));
+        if(nameOffset && nameOffset[i] > nameOffset[i + 1])
+            return fail("name offsets are not ascending at node " + std::to_string(i));
+    }
+    return true;
+}
+
+/**
+ * @brief mappedTree::scanStatistics 顺序扫描映射的孩子数组与标记位图求统计信息
+ * @param level 使用的指令集
+ * @return 全部结点的统计信息（未打开时为空）
+ */
+treeStatistics mappedTree::scanStatistics(SIMD_LEVEL level) const
+{
+    if(!isOpen())
+        return treeStatistics();
+    return scanTreeStatistics(leftChild, rightChild, leftTag, rightTag, nodeNum, level);
+}
+
+/**
+ * @brief mappedTree::clearThreadedTree 将线索还原为空指针（只修改本进程的映射副本）
+ */
+void mappedTree::clearThreadedTree()
+{
+    algorithm.clearThreadedTree(root);
+}
+
+void mappedTree::close()
+{
+    if(base){
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = fileHandle = nullptr;
+#else
+        munmap(base, length);
+#endif
+    }
+    base = nullptr;
+    length = 0;
+    nodeNum = 0;
+    root = nil;
+    leftChild = rightChild = parentNode = nullptr;
+    leftTag = rightTag = nullptr;
+    layoutX = layoutY = nullptr;
+    nameData = nullptr;
+    nameOffset = nullptr;
+}
+
+/**
+ * @brief mappedTree::map 以写时复制方式映射整个文件
+ */
+bool mappedTree::map(const std::string& path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE){
+        error = "cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0){
+        CloseHandle(file);
+        error = "cannot map empty file " + path;
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+    if(!view){
+        if(mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        error = "cannot map " + path;
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<char*>(view);
+    length = std::size_t(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0){
+        ::close(fd);
+        error = "cannot map empty file " + path;
+        return false;
+    }
+    void* view = mmap(nullptr, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(view == MAP_FAILED){
+        error = "cannot map " + path;
+        return false;
+    }
+    base = static_cast<char*>(view);
+    length = std::size_t(st.st_size);
+#endif
+    return true;
+}
+
+bool mappedTree::fail(const std::string& message)
+{
+    close();
+    error = message;
+    return false;
+}
@@ -0,0 +1,238 @@
+#ifndef TREESNAPSHOT_H
+#define TREESNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "binarytreenode.h"
+#include "traversal.h"
+#include "treeiterator.h"
+#include "arraytree.h"
+
+/*
+ * 二叉树的二进制快照
+ * 文件由固定长度的文件头与若干段组成，每段按64字节对齐：
+ *   左孩子、右孩子、双亲    uint32[n]（空为0xFFFFFFFF）
+ *   左、右标记位图          uint64[(n+63)/64]（置位表示THREAD）
+ *   布局坐标（可选）        float[n] x、float[n] y
+ *   结点名称（可选）        名称数据char[]，偏移uint64[n+1]
+ * 各数组与arrayTree的内存布局一致，打开时直接映射文件，无拷贝、无逐结点分配。
+ * 数值按本机字节序存储，文件头记录字节序，跨字节序的文件会被拒绝。
+ */
+
+namespace treeSnapshotFormat
+{
+    const char magic[8] = {'B', 'T', 'S', 'N', 'A', 'P', 0, 0};
+    const std::uint32_t version = 1;
+    const std::uint32_t byteOrderMark = 0x01020304u;
+    const std::uint64_t alignment = 64;
+
+    enum SECTION { LEFT_CHILD, RIGHT_CHILD, PARENT_NODE, LEFT_TAG, RIGHT_TAG,
+                   LAYOUT_X, LAYOUT_Y, NAME_DATA, NAME_OFFSET, SECTION_NUM };
+
+    struct header
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint64_t nodeNum;
+        std::uint32_t root;
+        std::uint32_t reserved;
+        std::uint64_t offset[SECTION_NUM];      // 段的起始位置，不存在的段为0
+        std::uint64_t size[SECTION_NUM];        // 段的字节数
+    };
+}
+
+
+// 快照的写出：顺序流式写入，不需要额外的整树缓冲
+class snapshotWriter
+{
+public:
+    typedef arrayTree::index_type index_type;
+    // 返回结点n的名称
+    typedef std::function<std::string(index_type n)> nameProvider;
+
+    // 可选的布局坐标，长度须为结点数
+    void setLayout(const float* _x, const float* _y);
+    // 可选的结点名称
+    void setNameProvider(nameProvider provider);
+
+    bool save(const arrayTree& tree, const std::string& path);
+    const std::string& getError() const;
+
+private:
+    const float* x = nullptr;
+    const float* y = nullptr;
+    nameProvider names;
+    std::string error;
+};
+
+
+class mappedTree;
+
+// mappedTree的结点访问策略（结点即下标）
+struct mappedTreeAccess
+{
+    typedef std::uint32_t node_type;
+
+    mappedTree* tree;
+
+    explicit mappedTreeAccess(mappedTree* _tree = nullptr): tree(_tree) {}
+
+    node_type null() const;
+    node_type left(node_type n) const;
+    node_type right(node_type n) const;
+    binaryTreeNode::TAG leftTag(node_type n) const;
+    binaryTreeNode::TAG rightTag(node_type n) const;
+    node_type leftAndTag(node_type n, binaryTreeNode::TAG& tag) const;
+    node_type rightAndTag(node_type n, binaryTreeNode::TAG& tag) const;
+    node_type parent(node_type n) const;
+    void setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const;
+    void setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const;
+};
+
+
+/*
+ * 映射到内存的快照
+ * open()只校验文件头并建立映射，耗时与结点数无关；遍历时按需从映射页读取。
+ * 映射为写时复制：线索化、Morris遍历等修改只作用于本进程，不会写回文件。
+ */
+class mappedTree
+{
+public:
+    typedef std::uint32_t index_type;
+    static const index_type nil = 0xFFFFFFFFu;     // 空结点
+
+    mappedTree();
+    ~mappedTree();
+    mappedTree(const mappedTree&) = delete;
+    mappedTree& operator=(const mappedTree&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    const std::string& getError() const;
+
+    // 逐结点检查下标是否越界、从根可达的部分是否为树（O(n)，用于不可信的文件）
+    bool verify();
+
+    // 顺序扫描映射的数组求统计信息（向量化，不沿树遍历）
+    treeStatistics scanStatistics(SIMD_LEVEL level = detectSimdLevel()) const;
+
+    std::size_t size() const { return nodeNum; }
+    index_type getRoot() const { return root; }
+
+    // 结点信息
+    index_type getLeftChild(index_type n) const { return leftChild[n]; }
+    index_type getRightChild(index_type n) const { return rightChild[n]; }
+    binaryTreeNode::TAG getLeftChildTag(index_type n) const { return (leftTag[n >> 6] >> (n & 63)) & 1u ? binaryTreeNode::THREAD : binaryTreeNode::LINK; }
+    binaryTreeNode::TAG getRightChildTag(index_type n) const { return (rightTag[n >> 6] >> (n & 63)) & 1u ? binaryTreeNode::THREAD : binaryTreeNode::LINK; }
+    index_type getParentNode(index_type n) const { return parentNode[n]; }
+    void setLeftChild(index_type n, index_type c, binaryTreeNode::TAG tag) { leftChild[n] = c; assignBit(leftTag, n, tag == binaryTreeNode::THREAD); }
+    void setRightChild(index_type n, index_type c, binaryTreeNode::TAG tag) { rightChild[n] = c; assignBit(rightTag, n, tag == binaryTreeNode::THREAD); }
+
+    // 布局坐标
+    bool hasLayout() const { return layoutX != nullptr; }
+    float getX(index_type n) const { return layoutX[n]; }
+    float getY(index_type n) const { return layoutY[n]; }
+
+    // 结点名称（不以'\0'结尾）
+    bool hasNames() const { return nameOffset != nullptr; }
+    const char* getName(index_type n, std::size_t& length) const
+    {
+        length = std::size_t(nameOffset[n + 1] - nameOffset[n]);
+        return nameData + nameOffset[n];
+    }
+
+    // 遍历（visit接收结点下标）
+    template<class Order, class Visitor>
+    void traversal(Visitor&& visit)
+    {
+        algorithm.traversal<Order>(root, visit);
+    }
+
+    template<class Order, class Visitor>
+    void traversal_Thr(Visitor&& visit)
+    {
+        algorithm.traversal_Thr<Order>(root, visit);
+    }
+
+    template<class Order, class Visitor>
+    void traversal_Morris(Visitor&& visit)
+    {
+        algorithm.traversal_Morris<Order>(root, visit);
+    }
+
+    template<class Order, class Visitor>
+    void createThreadedTree(Visitor&& visit)
+    {
+        algorithm.createThreadedTree<Order>(root, visit);
+    }
+
+    void clearThreadedTree();
+
+    // 惰性遍历区间（元素为结点下标）
+    template<class Order>
+    traversalRange<traversalIterator<Order, mappedTreeAccess> > range()
+    {
+        typedef traversalIterator<Order, mappedTreeAccess> iterator;
+        return traversalRange<iterator>(iterator(mappedTreeAccess(this), root), iterator(mappedTreeAccess(this)));
+    }
+
+    template<class Order>
+    traversalRange<threadedIterator<Order, mappedTreeAccess> > threadedRange()
+    {
+        typedef threadedIterator<Order, mappedTreeAccess> iterator;
+        return traversalRange<iterator>(iterator(mappedTreeAccess(this), root), iterator(mappedTreeAccess(this)));
+    }
+
+private:
+    // 映射区域
+    char* base = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+
+    std::size_t nodeNum = 0;
+    index_type root = nil;
+    index_type* leftChild = nullptr;
+    index_type* rightChild = nullptr;
+    index_type* parentNode = nullptr;
+    std::uint64_t* leftTag = nullptr;
+    std::uint64_t* rightTag = nullptr;
+    const float* layoutX = nullptr;
+    const float* layoutY = nullptr;
+    const char* nameData = nullptr;
+    const std::uint64_t* nameOffset = nullptr;
+    std::string error;
+    treeTraversal<mappedTreeAccess> algorithm;
+
+    bool map(const std::string& path);
+    bool fail(const std::string& message);
+
+    static void assignBit(std::uint64_t* bits, index_type n, bool value)
+    {
+        std::uint64_t mask = std::uint64_t(1) << (n & 63);
+        if(value)
+            bits[n >> 6] |= mask;
+        else
+            bits[n >> 6] &= ~mask;
+    }
+};
+
+
+inline mappedTreeAccess::node_type mappedTreeAccess::null() const { return mappedTree::nil; }
+inline mappedTreeAccess::node_type mappedTreeAccess::left(node_type n) const { return tree->getLeftChild(n); }
+inline mappedTreeAccess::node_type mappedTreeAccess::right(node_type n) const { return tree->getRightChild(n); }
+inline binaryTreeNode::TAG mappedTreeAccess::leftTag(node_type n) const { return tree->getLeftChildTag(n); }
+inline binaryTreeNode::TAG mappedTreeAccess::rightTag(node_type n) const { return tree->getRightChildTag(n); }
+inline mappedTreeAccess::node_type mappedTreeAccess::leftAndTag(node_type n, binaryTreeNode::TAG& tag) const { tag = leftTag(n); return left(n); }
+inline mappedTreeAccess::node_type mappedTreeAccess::rightAndTag(node_type n, binaryTreeNode::TAG& tag) const { tag = rightTag(n); return right(n); }
+inline mappedTreeAccess::node_type mappedTreeAccess::parent(node_type n) const { return tree->getParentNode(n); }
+inline void mappedTreeAccess::setLeft(node_type n, node_type c, binaryTreeNode::TAG tag) const { tree->setLeftChild(n, c, tag); }
+inline void mappedTreeAccess::setRight(node_type n, node_type c, binaryTreeNode::TAG tag) const { tree->setRightChild(n, c, tag); }
+
+#endif // TREESNAPSHOT_H
@@ -0,0 +1,217 @@
+#include "treestatistics.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TREE_STATISTICS_GNU_X86
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define TREE_STATISTICS_MSVC_X86
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace
+{
+    const std::uint32_t nil = 0xFFFFFFFFu;
+
+    inline unsigned popCount(std::uint64_t x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return unsigned(__builtin_popcountll(x));
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return unsigned((x * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    // 由一个字（64个结点）的空孩子掩码与标记位累加统计量，valid为有效结点的掩码
+    inline void accumulate(treeStatistics& s, std::uint64_t leftNull, std::uint64_t rightNull,
+                           std::uint64_t leftTag, std::uint64_t rightTag, std::uint64_t valid)
+    {
+        leftNull &= valid;
+        rightNull &= valid;
+        leftTag &= valid;
+        rightTag &= valid;
+        s.leafNum += popCount((leftNull | leftTag) & (rightNull | rightTag));
+        s.leftThreadNum += popCount(leftTag);
+        s.rightThreadNum += popCount(rightTag);
+        s.leftNullNum += popCount(leftNull);
+        s.rightNullNum += popCount(rightNull);
+    }
+
+    // 一个整字的空孩子掩码（定长循环，编译器可展开或自动向量化）
+    inline std::uint64_t nullMask(const std::uint32_t* children)
+    {
+        std::uint64_t mask = 0;
+        for(unsigned j = 0; j < 64; j += 8){
+            unsigned byte = unsigned(children[j] == nil) | unsigned(children[j + 1] == nil) << 1
+                    | unsigned(children[j + 2] == nil) << 2 | unsigned(children[j + 3] == nil) << 3
+                    | unsigned(children[j + 4] == nil) << 4 | unsigned(children[j + 5] == nil) << 5
+                    | unsigned(children[j + 6] == nil) << 6 | unsigned(children[j + 7] == nil) << 7;
+            mask |= std::uint64_t(byte) << j;
+        }
+        return mask;
+    }
+
+    // 标量实现：处理第begin个字起的各字，最后一个字可以不满
+    void scanScalar(treeStatistics& s, const std::uint32_t* left, const std::uint32_t* right,
+                    const std::uint64_t* leftTag, const std::uint64_t* rightTag,
+                    std::size_t begin, std::size_t nodeNum)
+    {
+        std::size_t wordNum = nodeNum / 64;
+        for(std::size_t w = begin; w < wordNum; ++w)
+            accumulate(s, nullMask(left + w * 64), nullMask(right + w * 64), leftTag[w], rightTag[w], ~std::uint64_t(0));
+
+        for(std::size_t w = wordNum > begin ? wordNum : begin; w * 64 < nodeNum; ++w){
+            std::size_t base = w * 64, count = nodeNum - base < 64 ? nodeNum - base : 64;
+            std::uint64_t leftNull = 0, rightNull = 0;
+            for(std::size_t j = 0; j < count; ++j){
+                leftNull |= std::uint64_t(left[base + j] == nil) << j;
+                rightNull |= std::uint64_t(right[base + j] == nil) << j;
+            }
+            std::uint64_t valid = count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+            accumulate(s, leftNull, rightNull, leftTag[w], rightTag[w], valid);
+        }
+    }
+
+#if defined(TREE_STATISTICS_GNU_X86) || defined(TREE_STATISTICS_MSVC_X86)
+#ifdef TREE_STATISTICS_GNU_X86
+#define TREE_STATISTICS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define TREE_STATISTICS_TARGET(isa)
+#endif
+
+    // AVX2：每次比较8个下标，movemask得到8位掩码，8次拼成一个字；返回处理完的整字数
+    TREE_STATISTICS_TARGET("avx2")
+    std::size_t scanAvx2(treeStatistics& s, const std::uint32_t* left, const std::uint32_t* right,
+                         const std::uint64_t* leftTag, const std::uint64_t* rightTag, std::size_t nodeNum)
+    {
+        const __m256i nils = _mm256_set1_epi32(-1);
+        std::size_t wordNum = nodeNum / 64;
+        for(std::size_t w = 0; w < wordNum; ++w){
+            const std::uint32_t* l = left + w * 64;
+            const std::uint32_t* r = right + w * 64;
+            std::uint64_t leftNull = 0, rightNull = 0;
+            for(int k = 0; k < 8; ++k){
+                __m256i lv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(l + k * 8));
+                __m256i rv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + k * 8));
+                leftNull |= std::uint64_t(unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lv, nils))))) << (k * 8);
+                rightNull |= std::uint64_t(unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(rv, nils))))) << (k * 8);
+            }
+            accumulate(s, leftNull, rightNull, leftTag[w], rightTag[w], ~std::uint64_t(0));
+        }
+        return wordNum;
+    }
+
+    // AVX-512：每次比较16个下标，比较结果直接为16位掩码，4次拼成一个字
+    TREE_STATISTICS_TARGET("avx512f")
+    std::size_t scanAvx512(treeStatistics& s, const std::uint32_t* left, const std::uint32_t* right,
+                           const std::uint64_t* leftTag, const std::uint64_t* rightTag, std::size_t nodeNum)
+    {
+        const __m512i nils = _mm512_set1_epi32(-1);
+        std::size_t wordNum = nodeNum / 64;
+        for(std::size_t w = 0; w < wordNum; ++w){
+            const std::uint32_t* l = left + w * 64;
+            const std::uint32_t* r = right + w * 64;
+            std::uint64_t leftNull = 0, rightNull = 0;
+            for(int k = 0; k < 4; ++k){
+                __m512i lv = _mm512_loadu_si512(l + k * 16);
+                __m512i rv = _mm512_loadu_si512(r + k * 16);
+                leftNull |= std::uint64_t(_mm512_cmpeq_epi32_mask(lv, nils)) << (k * 16);
+                rightNull |= std::uint64_t(_mm512_cmpeq_epi32_mask(rv, nils)) << (k * 16);
+            }
+            accumulate(s, leftNull, rightNull, leftTag[w], rightTag[w], ~std::uint64_t(0));
+        }
+        return wordNum;
+    }
+
+#ifdef TREE_STATISTICS_MSVC_X86
+    // CPU支持且操作系统保存了相应寄存器（XCR0）
+    SIMD_LEVEL detectMsvc()
+    {
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7)
+            return SCALAR_LEVEL;
+        __cpuid(info, 1);
+        bool hasOsxsave = (info[2] >> 27) & 1, hasAvx = (info[2] >> 28) & 1;
+        if(!hasOsxsave || !hasAvx)
+            return SCALAR_LEVEL;
+        unsigned long long xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        if((xcr0 & 0xE6) == 0xE6 && ((info[1] >> 16) & 1))
+            return AVX512_LEVEL;
+        if((xcr0 & 0x6) == 0x6 && ((info[1] >> 5) & 1))
+            return AVX2_LEVEL;
+        return SCALAR_LEVEL;
+    }
+#endif
+#endif
+
+    SIMD_LEVEL detect()
+    {
+#if defined(TREE_STATISTICS_GNU_X86)
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return AVX512_LEVEL;
+        if(__builtin_cpu_supports("avx2"))
+            return AVX2_LEVEL;
+        return SCALAR_LEVEL;
+#elif defined(TREE_STATISTICS_MSVC_X86)
+        return detectMsvc();
+#else
+        return SCALAR_LEVEL;
+#endif
+    }
+}
+
+bool treeStatistics::operator==(const treeStatistics& other) const
+{
+    return nodeNum == other.nodeNum && leafNum == other.leafNum
+            && leftThreadNum == other.leftThreadNum && rightThreadNum == other.rightThreadNum
+            && leftNullNum == other.leftNullNum && rightNullNum == other.rightNullNum;
+}
+
+const char* simdLevelName(SIMD_LEVEL level)
+{
+    static const char* names[SIMD_LEVEL_NUM] = { "scalar", "avx2", "avx512" };
+    return names[level];
+}
+
+SIMD_LEVEL detectSimdLevel()
+{
+    static const SIMD_LEVEL level = detect();
+    return level;
+}
+
+/**
+ * @brief scanTreeStatistics 顺序扫描结点数组求统计信息
+ * @param left 左孩子下标数组
+ * @param right 右孩子下标数组
+ * @param leftTag 左标记位图
+ * @param rightTag 右标记位图
+ * @param nodeNum 结点数
+ * @param level 使用的指令集（不超过本机支持的最高指令集）
+ * @return 统计信息
+ */
+treeStatistics scanTreeStatistics(const std::uint32_t* left, const std::uint32_t* right,
+                                  const std::uint64_t* leftTag, const std::uint64_t* rightTag,
+                                  std::size_t nodeNum, SIMD_LEVEL level)
+{
+    treeStatistics s;
+    s.nodeNum = nodeNum;
+    if(level > detectSimdLevel())
+        level = detectSimdLevel();
+
+    // 向量实现处理整字，剩余不满一字的结点由标量实现处理
+    std::size_t done = 0;
+#if defined(TREE_STATISTICS_GNU_X86) || defined(TREE_STATISTICS_MSVC_X86)
+    if(level == AVX512_LEVEL)
+        done = scanAvx512(s, left, right, leftTag, rightTag, nodeNum);
+    else if(level == AVX2_LEVEL)
+        done = scanAvx2(s, left, right, leftTag, rightTag, nodeNum);
+#endif
+    scanScalar(s, left, right, leftTag, rightTag, done, nodeNum);
+    return s;
+}
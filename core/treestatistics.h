@@ -0,0 +1,48 @@
+#ifndef TREESTATISTICS_H
+#define TREESTATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * 整树统计的向量化扫描
+ * arrayTree与快照中，孩子为连续的32位下标数组（空为0xFFFFFFFF），标记为位图（置位表示THREAD），
+ * 叶子数、线索数、空孩子数都只与单个结点有关，因此不需要沿树遍历，顺序扫描数组即可：
+ * 每64个结点把孩子与空下标的比较结果拼成64位掩码，与同一字的标记位图做位运算后计数。
+ * 按运行时检测到的指令集选用AVX-512 / AVX2实现，其他平台使用标量实现，结果完全相同。
+ * 扫描覆盖存储中的全部结点，与从根出发的遍历一致的前提是所有结点都属于这棵树。
+ */
+
+// 统计结果
+struct treeStatistics
+{
+    std::uint64_t nodeNum = 0;
+    std::uint64_t leafNum = 0;          // 左右均无LINK孩子的结点数（与countLeafNode一致）
+    std::uint64_t leftThreadNum = 0;    // 左标记为THREAD的结点数
+    std::uint64_t rightThreadNum = 0;
+    std::uint64_t leftNullNum = 0;      // 左孩子下标为空的结点数（不论标记）
+    std::uint64_t rightNullNum = 0;
+
+    bool operator==(const treeStatistics& other) const;
+    bool operator!=(const treeStatistics& other) const { return !(*this == other); }
+};
+
+
+// 扫描使用的指令集
+enum SIMD_LEVEL { SCALAR_LEVEL, AVX2_LEVEL, AVX512_LEVEL, SIMD_LEVEL_NUM };
+
+const char* simdLevelName(SIMD_LEVEL level);
+
+// 本机（CPU与操作系统均支持）可用的最高指令集，首次调用时检测
+SIMD_LEVEL detectSimdLevel();
+
+/**
+ * 扫描结点数组求统计信息
+ * left/right为孩子下标数组，leftTag/rightTag为标记位图（(nodeNum + 63) / 64个字），
+ * level高于本机支持时按本机支持的最高指令集执行
+ */
+treeStatistics scanTreeStatistics(const std::uint32_t* left, const std::uint32_t* right,
+                                  const std::uint64_t* leftTag, const std::uint64_t* rightTag,
+                                  std::size_t nodeNum, SIMD_LEVEL level = detectSimdLevel());
+
+#endif // TREESTATISTICS_H
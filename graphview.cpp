@@ -1,5 +1,13 @@
 #include "graphview.h"
 
+// 细节层次的缩放阈值
+static const qreal simpleScale = 0.6;
+static const qreal aggregateScale = 0.15;
+// 缩放范围
+static const qreal minScale = 0.005, maxScale = 4;
+// 聚合格子在屏幕上的大致边长（像素）
+static const qreal aggregateCellPixels = 8;
+
 /* graphicsView */
 
 /**
@@ -10,7 +18,7 @@
  * @param _height
  * @param parent 对象树的父亲指针
  */
-graphicsView::graphicsView(qint16 _leftTopx, qint16 _leftTopy, qint16 _width, qint16 _height, QWidget* parent):
+graphicsView::graphicsView(int _leftTopx, int _leftTopy, int _width, int _height, QWidget* parent):
     QGraphicsView (parent),
     leftTopx(_leftTopx),
     leftTopy(_leftTopy),
@@ -27,10 +35,41 @@ graphicsView::graphicsView(qint16 _leftTopx, qint16 _leftTopy, qint16 _width, qi
     this->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform); // 抗锯齿
     this->setMouseTracking(true);   // 不按下时也追踪鼠标
 
-    // 绑定graphicsScene
+    // 绑定graphicsScene（场景不限于画布大小，可缩放、拖动查看）
     graphicsScene = new QGraphicsScene(this);
-    graphicsScene->setSceneRect(0, 0, width, height);
+    graphicsScene->setSceneRect(-(1 << 22), -(1 << 22), 1 << 23, 1 << 23);
     this->setScene(graphicsScene);
+    this->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    this->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    this->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+    this->setOptimizationFlag(QGraphicsView::DontAdjustForAntialiasing);
+    this->centerOn(width / 2, height / 2);     // 初始时场景坐标与画布坐标一致
+
+    // 边与线索各自合并为一个图元
+    edges = new graphicsEdgeBatchItem();
+    threads = new graphicsThreadBatchItem();
+    curEdge = new graphicsEdgeItem();
+    graphicsScene->addItem(edges);
+    graphicsScene->addItem(threads);
+    graphicsScene->addItem(curEdge);
+
+    // 结点间距
+    layout.setSeparation(float(3 * defaultVexRadius), float(4 * defaultVexRadius));
+
+    // 遍历动画调度
+    scheduler = new stepScheduler(500, this);
+    connect(scheduler, &stepScheduler::stepReady, this, &graphicsView::handleStep);
+    connect(scheduler, &stepScheduler::seeked, this, &graphicsView::handleSeeked);
+    connect(scheduler, &stepScheduler::progressChanged, this, [this](std::size_t position, std::size_t length){
+        emit traceProgressChanged(qint64(position), qint64(length));
+    });
+    connect(scheduler, &stepScheduler::finished, this, &graphicsView::handleTraversalFinished);
+
+    // 结点动画
+    animator = new animationDriver(300, this);
+
+    // 每次遍历记录统计信息（树的规模有限，开销可忽略）
+    binTree.setMetricsEnabled(true);
 }
 
 graphicsView::~graphicsView()
@@ -44,11 +83,24 @@ graphicsView::~graphicsView()
  */
 inline graphicsVexItem* graphicsView::addVex(QPointF position)
 {
-    graphicsVexItem* newvex = new graphicsVexItem(defaultVexRadius, position, currentVexColor, (currentVexColor == defaultVexColor ? HighlightVexColor : defaultVexColor), vexNum);
-    graphicsScene->addItem(newvex);
-    connect(newvex, &graphicsVexItem::startNewVex, this, &graphicsView::handleNewVexCreate);
-    connect(newvex, &graphicsVexItem::startNewThread, this, &graphicsView::handleNewThreadCreate);
-    ++vexNum;      
+    graphicsVexItem* newvex;
+    QColor color2 = (currentVexColor == defaultVexColor ? HighlightVexColor : defaultVexColor);
+    if(std::size_t(vexNum) < vexes.size()){
+        // 复用结点池中的结点
+        newvex = vexes[std::size_t(vexNum)];
+        newvex->reset(position, currentVexColor, color2);
+    }
+    else{
+        newvex = new graphicsVexItem(defaultVexRadius, position, currentVexColor, color2, vexNum, animator);
+        graphicsScene->addItem(newvex);
+        connect(newvex, &graphicsVexItem::startNewVex, this, &graphicsView::handleNewVexCreate);
+        connect(newvex, &graphicsVexItem::startNewThread, this, &graphicsView::handleNewThreadCreate);
+        connect(newvex, &graphicsVexItem::visited, this, &graphicsView::handleVexVisited);
+        vexes.push_back(newvex);
+    }
+    ++vexNum;
+    applyLevelOfDetail(newvex);
+    isAggregateDirty = true;
     return newvex;
 }
 
@@ -57,13 +109,132 @@ inline graphicsVexItem* graphicsView::addVex(QPointF position)
  */
 inline void graphicsView::removeThread()
 {
-    graphicsThreadItem* thread;
-    while(!threads.empty()){
-        thread = threads.back();
-        threads.pop_back();
-        graphicsScene->removeItem(thread);
-        delete thread;
+    threads->clear();
+}
+
+/**
+ * @brief graphicsView::moveVex 按布局结果移动结点
+ * @param node 结点
+ * @param x 相对根结点的横坐标
+ * @param y 相对根结点的纵坐标
+ */
+void graphicsView::moveVex(binaryTreeNode* node, float x, float y)
+{
+    static_cast<graphicsVexItem*>(node)->setPosition(layoutOrigin + QPointF(qreal(x), qreal(y)));
+    edges->invalidate();
+    isAggregateDirty = true;
+}
+
+/**
+ * @brief graphicsView::updateLevelOfDetail 按当前缩放比例切换细节层次
+ *        只在跨越阈值时逐个结点切换显示状态
+ */
+void graphicsView::updateLevelOfDetail()
+{
+    qreal currentScale = transform().m11();
+    LEVEL_OF_DETAIL lod = currentScale >= simpleScale ? DETAIL : (currentScale >= aggregateScale ? SIMPLE : AGGREGATE);
+    if(lod == levelOfDetail){
+        if(lod == AGGREGATE)
+            viewport()->update();   // 聚合格子随缩放变化
+        return;
+    }
+
+    levelOfDetail = lod;
+    animator->setEnabled(lod == DETAIL);
+    setRenderHint(QPainter::Antialiasing, lod == DETAIL);
+    for(qint64 i = 0; i < vexNum; ++i)
+        applyLevelOfDetail(vexes[i]);
+    edges->setVisible(lod != AGGREGATE);
+    threads->setVisible(lod == DETAIL);
+    viewport()->update();
+}
+
+/**
+ * @brief graphicsView::applyLevelOfDetail 按当前细节层次设置结点与名称的显示
+ * @param vex 结点
+ */
+void graphicsView::applyLevelOfDetail(graphicsVexItem* vex)
+{
+    vex->setVisible(levelOfDetail != AGGREGATE);
+    vex->setNameVisible(levelOfDetail == DETAIL);
+}
+
+/**
+ * @brief graphicsView::rebuildAggregate 统计每个格子中的结点数
+ * @param cellSize 格子边长（场景坐标）
+ */
+void graphicsView::rebuildAggregate(qreal cellSize)
+{
+    QHash<quint64, qint64> count;
+    count.reserve(int(qMin<qint64>(vexNum, 1 << 20)));
+    for(qint64 i = 0; i < vexNum; ++i){
+        QPointF p = vexes[i]->getPosition();
+        quint64 key = (quint64(quint32(qFloor(p.x() / cellSize))) << 32) | quint32(qFloor(p.y() / cellSize));
+        ++count[key];
+    }
+
+    aggregateCells.clear();
+    aggregateCells.reserve(count.size());
+    for(QHash<quint64, qint64>::const_iterator it = count.constBegin(); it != count.constEnd(); ++it){
+        qint32 cx = qint32(quint32(it.key() >> 32)), cy = qint32(quint32(it.key()));
+        aggregateCells.push_back(aggregateCell{QRectF(cx * cellSize, cy * cellSize, cellSize, cellSize), it.value()});
+    }
+    aggregateCellSize = cellSize;
+    isAggregateDirty = false;
+}
+
+/**
+ * @brief graphicsView::drawForeground 聚合层次下以色块代替结点，颜色深浅表示结点密度
+ * @param painter
+ * @param rect 需要重绘的区域（场景坐标）
+ */
+void graphicsView::drawForeground(QPainter *painter, const QRectF &rect)
+{
+    if(levelOfDetail != AGGREGATE || vexNum == 0)
+        return;
+
+    qreal cellSize = qPow(2, qCeil(std::log2(aggregateCellPixels / transform().m11())));
+    if(isAggregateDirty || cellSize != aggregateCellSize)
+        rebuildAggregate(cellSize);
+
+    painter->setPen(Qt::NoPen);
+    QColor color = defaultVexColor;
+    for(const aggregateCell& cell : aggregateCells){
+        if(!cell.rect.intersects(rect))
+            continue;
+        color.setAlpha(qMin(255, 96 + 32 * int(std::log2(cell.vexNum))));
+        painter->fillRect(cell.rect, color);
+    }
+}
+
+/**
+ * @brief graphicsView::wheelEvent 以鼠标所在位置为中心缩放
+ * @param e
+ */
+void graphicsView::wheelEvent(QWheelEvent *e)
+{
+    qreal factor = qPow(1.0015, e->angleDelta().y());
+    qreal newScale = transform().m11() * factor;
+    if(newScale < minScale)
+        factor = minScale / transform().m11();
+    else if(newScale > maxScale)
+        factor = maxScale / transform().m11();
+    this->scale(factor, factor);
+    updateLevelOfDetail();
+}
+
+/**
+ * @brief graphicsView::mouseReleaseEvent 结束拖动画布
+ * @param e
+ */
+void graphicsView::mouseReleaseEvent(QMouseEvent *e)
+{
+    if(isPanning){
+        isPanning = false;
+        setCursor(Qt::ArrowCursor);
+        return;
     }
+    QGraphicsView::mouseReleaseEvent(e);
 }
 
 /**
@@ -72,24 +243,44 @@ inline void graphicsView::removeThread()
  */
 void graphicsView::mousePressEvent(QMouseEvent *e)
 {
+    QPointF scenePos = mapToScene(e->pos());
+
+    // 中键，或在空白处按下左键时拖动画布
+    if(e->button() == Qt::MiddleButton || (vexNum && !isNewVexCreating && e->button() == Qt::LeftButton && !itemAt(e->pos()))){
+        isPanning = true;
+        panStart = e->pos();
+        setCursor(Qt::ClosedHandCursor);
+        return;
+    }
+
     if(vexNum == 0){
-        graphicsVexItem* root = addVex(e->localPos());
-        binTree = new binaryTree(root);
+        graphicsVexItem* root = addVex(scenePos);
+        binTree.setRoot(root);
+        layoutOrigin = root->getPosition();
+        layout.layout(root, [this](binaryTreeNode* n, float x, float y){ moveVex(n, x, y); });
         emit tipsChanged("Click the node with left/right button to create a correspoding child node.");
-        emit leafNodeNumChanged(binTree->countLeafNode());
+        emit leafNodeNumChanged(qint64(binTree.getLeafNodeNum()));
     } 
-    else if(isNewVexCreating && getDistance(curParentNode->getPosition(), e->localPos()) > 3 * defaultVexRadius){
+    else if(isNewVexCreating && getDistance(curParentNode->getPosition(), scenePos) > 3 * defaultVexRadius){
         isNewVexCreating = false;
         setCursor(Qt::ArrowCursor);
-        graphicsVexItem* newvex = addVex(e->localPos());
+        graphicsVexItem* newvex = addVex(scenePos);
 
-        if(isLeftChild)
-            curParentNode->leftChild = newvex;
-        else
-            curParentNode->rightChild = newvex;
+        // 结点将被移动，已画出的线索不再适用；树的结构改变，已记录的轨迹作废
+        if(isTreeThreaded){
+            removeThread();
+            binTree.clearThreadedTree();
+            isTreeThreaded = false;
+        }
+        isTraceValid = false;
+
+        binTree.insertChild(curParentNode, newvex, isLeftChild);     // 增量更新统计信息
 
-        curEdge->setPen(curEdge->defaultPen);
-        emit leafNodeNumChanged(binTree->countLeafNode());
+        // 拖动用的虚线换成正式的边
+        curEdge->hide();
+        edges->addEdge(curParentNode, newvex);
+        layout.insert(newvex, [this](binaryTreeNode* n, float x, float y){ moveVex(n, x, y); });     // 增量重新布局
+        emit leafNodeNumChanged(qint64(binTree.getLeafNodeNum()));
 
         emit tipsChanged("Continue to click a node with left/right button to create a left/right child.");
     }
@@ -105,8 +296,15 @@ void graphicsView::mousePressEvent(QMouseEvent *e)
  */
 void graphicsView::mouseMoveEvent(QMouseEvent *e)
 {
+    if(isPanning){
+        QPoint delta = e->pos() - panStart;
+        panStart = e->pos();
+        horizontalScrollBar()->setValue(horizontalScrollBar()->value() - delta.x());
+        verticalScrollBar()->setValue(verticalScrollBar()->value() - delta.y());
+        return;
+    }
     if(isNewVexCreating){
-        curEdge->setLine(QLine(curParentNode->getPosition().toPoint(), e->localPos().toPoint()));
+        curEdge->setLine(QLineF(curParentNode->getPosition(), mapToScene(e->pos())));
         emit tipsChanged("Drag and click again to create a new node.");
     }
 }
@@ -122,9 +320,8 @@ void graphicsView::handleNewVexCreate(graphicsVexItem* parentNode, bool _isLeftC
     // 要求不在遍历状态
     if(!isTraversal){
         curParentNode = parentNode;
-        curEdge = new graphicsEdgeItem(parentNode, parentNode->getPosition().toPoint());
-        curEdge->setZValue(-1);
-        graphicsScene->addItem(curEdge);
+        curEdge->setLine(QLineF(parentNode->getPosition(), parentNode->getPosition()));
+        curEdge->show();
         isNewVexCreating = true;
         setCursor(Qt::CrossCursor);
         isLeftChild = _isLeftChild;
@@ -132,97 +329,244 @@ void graphicsView::handleNewVexCreate(graphicsVexItem* parentNode, bool _isLeftC
 }
 
 /**
- * @brief graphicsView::handleNewThreadCreate 可视化绘制新线索
+ * @brief graphicsView::handleNewThreadCreate 记录新线索，待动画播放到时再绘制
  * @param start 当前结点
  * @param end 前驱/后继结点
  * @param position 左/右孩子处
  */
 void graphicsView::handleNewThreadCreate(graphicsVexItem *start, graphicsVexItem *end, enum THREAD_POSITION position)
 {
-    if(start && end){
-        graphicsThreadItem* newThread = new graphicsThreadItem(start, end, position);
-        graphicsScene->addItem(newThread);
-        threads.push_back(newThread);
-    }
+    if(isThreadRecorded && start && end)
+        scheduler->addThread(start->getId(), end->getId(), position == THREAD_POSITION::LEFT);
+}
+
+/**
+ * @brief graphicsView::handleVexVisited 记录结点的访问，待动画播放
+ * @param vex 被访问的结点
+ */
+void graphicsView::handleVexVisited(graphicsVexItem* vex)
+{
+    scheduler->addVisit(vex->getId());
+}
+
+/**
+ * @brief graphicsView::drawThread 可视化绘制新线索
+ * @param start 当前结点
+ * @param end 前驱/后继结点
+ * @param position 左/右孩子处
+ */
+void graphicsView::drawThread(graphicsVexItem *start, graphicsVexItem *end, enum THREAD_POSITION position)
+{
+    threads->addThread(start, end, position);
 }
 
 /**
- * @brief graphicsView::handleStartTraversal
+ * @brief graphicsView::handleStartTraversal 全速执行遍历并记录轨迹，再交给调度器逐拍播放
+ *        树与遍历模式未变时直接回放已记录的轨迹；播放过程中再次点击则暂停/继续
  */
 void graphicsView::handleStartTraversal()
 {
+    if(scheduler->isActive()){
+        scheduler->setPaused(!scheduler->isPaused());
+        emit traversalPaused(scheduler->isPaused());
+        return;
+    }
+
     if(vexNum){
         emit traversalStart();
         isTraversal = true;     // 开始遍历 禁用添加结点
 
+        if(isTraceValid){
+            scheduler->start();     // 回放，从头恢复状态
+            return;
+        }
+
         // 清除之前的线索
         removeThread();     // 清除线索的可视化部分
-        binTree->clearThreadedTree();   // 清楚树结构中穿好的线索
-
-        if(isThreaded){
-            emit tipsChanged("Creating a threaded binary tree...");
-            switch (traversalMode) {
-                case binaryTree::PREORDER_TRAVERSAL:
-                    binTree->createThreadedTree(traversalMode);
-                    emit tipsChanged("The threaded binary tree creation is completed.");
-                    waitForSeconds(2);
-                    emit tipsChanged("Executing threaded binary tree traversal...");
-                    binTree->preOrderTraversal_Thr();
-                    break;
-                case binaryTree::INORDER_TRAVERSAL:
-                    binTree->createThreadedTree(traversalMode);
-                    emit tipsChanged("The threaded binary tree creation is completed.");
-                    waitForSeconds(2);
-                    emit tipsChanged("Executing threaded binary tree traversal...");
-                    binTree->inOrderTraversal_Thr();
-                    break;
-                default:
-                    binTree->createThreadedTree(traversalMode);
-                    emit tipsChanged("The threaded binary tree creation is completed.");
-                    currentVexColor = (currentVexColor == defaultVexColor ? HighlightVexColor : defaultVexColor);   // 反转结点颜色记录
-            }
-            emit tipsChanged("The traversal is done. Choose different mode to try again.");
+        binTree.clearThreadedTree();   // 清楚树结构中穿好的线索
+        isTreeThreaded = false;
+        scheduler->clear(std::size_t(vexNum));
+        binTree.resetMetrics();        // 统计只包含本次的线索化与遍历
+
+        // 记录开始时各结点的颜色，跳转时据访问次数的奇偶性恢复
+        traceStartParity.assign((std::size_t(vexNum) + 63) / 64, 0);
+        for(qint64 i = 0; i < vexNum; ++i)
+            if(vexes[i]->brush().color() == vexes[i]->color2)
+                traceStartParity[std::size_t(i) >> 6] |= std::uint64_t(1) << (i & 63);
+
+        // 结点的访问与线索的建立通过信号记录到调度器中
+        if(traversalMethod != binaryTree::STACK_TRAVERSAL && traversalMode == binaryTree::LEVELORDER_TRAVERSAL){
+            scheduler->addTips("Level-order traversal has no threaded or Morris form. Executing it with a queue...");
+            binTree.traverse(traversalMode, binaryTree::STACK_TRAVERSAL);
+        }
+        else if(traversalMethod == binaryTree::THREADED_TRAVERSAL){
+            scheduler->addTips("Creating a threaded binary tree...");
+            binTree.createThreadedTree(traversalMode);
+            isTreeThreaded = true;
+            scheduler->addTips("The threaded binary tree creation is completed.");
+            scheduler->addPause(4);
+            scheduler->addTips("Executing threaded binary tree traversal...");
+            binTree.traverse(traversalMode, binaryTree::THREADED_TRAVERSAL);
+        }
+        else if(traversalMethod == binaryTree::MORRIS_TRAVERSAL){
+            // Morris遍历临时借用空指针作线索并随即拆除，这些线索不记录也不绘制
+            scheduler->addTips("Executing Morris traversal (temporary threads, no stack)...");
+            isThreadRecorded = false;
+            binTree.traverse(traversalMode, binaryTree::MORRIS_TRAVERSAL);
+            isThreadRecorded = true;
         }
         else{
-            emit tipsChanged("Executing binary tree traversal...");
-            switch (traversalMode) {
-                case binaryTree::PREORDER_TRAVERSAL:
-                    binTree->preOrderTraversal();
-                    break;
-                case binaryTree::INORDER_TRAVERSAL:
-                    binTree->inOrderTraversal();
-                    break;
-                case binaryTree::POSTORDER_TRAVERSAL:
-                    binTree->postOrderTraversal();
-                    break;
-            }
-            currentVexColor = (currentVexColor == defaultVexColor ? HighlightVexColor : defaultVexColor);   // 反转结点颜色记录
-            emit tipsChanged("The traversal is done. Choose different mode to try again.");
+            scheduler->addTips("Executing binary tree traversal...");
+            binTree.traverse(traversalMode, binaryTree::STACK_TRAVERSAL);
         }
+        scheduler->addTips("The traversal is done. Choose different mode to try again.");
+        emit metricsChanged(binTree.getMetrics());
+        isTraceValid = true;
 
-        emit traversalEnd();
-        isTraversal = false;    // 结束遍历，允许添加结点
+        scheduler->start();
+    }
+}
+
+/**
+ * @brief graphicsView::handleStep 播放一步动画
+ * @param step 调度器取出的步骤
+ */
+void graphicsView::handleStep(const traversalStep& step)
+{
+    switch(step.kind){
+        case traversalStep::VISIT:
+            vexes[step.node]->playVisit();
+            break;
+        case traversalStep::LEFT_THREAD:
+            drawThread(vexes[step.node], vexes[step.target], THREAD_POSITION::LEFT);
+            break;
+        case traversalStep::RIGHT_THREAD:
+            drawThread(vexes[step.node], vexes[step.target], THREAD_POSITION::RIGHT);
+            break;
+        case traversalStep::TIPS:
+            emit tipsChanged(step.tips);
+            break;
+        case traversalStep::PAUSE:
+            break;
+    }
+}
+
+/**
+ * @brief graphicsView::handleSeeked 跳转后按轨迹恢复该位置的画面，不重新执行遍历
+ * @param position 前position个事件已生效
+ */
+void graphicsView::handleSeeked(std::size_t position)
+{
+    const traversalTrace& trace = scheduler->getTrace();
+
+    // 结点颜色：开始时的颜色与访问次数的奇偶性
+    trace.parityBefore(position, seekParity);
+    for(qint64 i = 0; i < vexNum; ++i){
+        std::uint64_t mask = std::uint64_t(1) << (i & 63);
+        bool isColor2 = (seekParity[std::size_t(i) >> 6] ^ traceStartParity[std::size_t(i) >> 6]) & mask;
+        vexes[i]->setBrush(isColor2 ? vexes[i]->color2 : vexes[i]->color);
+    }
+
+    // 线索：前threadNum条，后退时重画
+    std::size_t threadNum = trace.threadNumBefore(position);
+    std::size_t drawnNum = threads->size();
+    if(threadNum < drawnNum){
+        removeThread();
+        drawnNum = 0;
+    }
+    for(std::size_t rank = drawnNum; rank < threadNum; ++rank){
+        std::size_t p = trace.getThreadPosition(rank);
+        drawThread(vexes[trace.getValue(p)], vexes[trace.getThreadTarget(rank)],
+                   trace.getKind(p) == traversalTrace::LEFT_THREAD ? THREAD_POSITION::LEFT : THREAD_POSITION::RIGHT);
+    }
+
+    QString tips = scheduler->getTips(position);
+    if(!tips.isEmpty())
+        emit tipsChanged(tips);
+}
+
+/**
+ * @brief graphicsView::enterReplay 不在播放中时跳转或单步，进入暂停的回放状态
+ * @return 是否有可回放的轨迹
+ */
+bool graphicsView::enterReplay()
+{
+    if(!isTraceValid || scheduler->isEmpty())
+        return false;
+    if(!scheduler->isActive()){
+        emit traversalStart();
+        isTraversal = true;
     }
+    else if(!scheduler->isPaused())
+        scheduler->setPaused(true);     // 单步与拖动时先暂停
+    emit traversalPaused(true);
+    return true;
+}
+
+/**
+ * @brief graphicsView::handleSeek 跳转到轨迹中的某一位置
+ * @param position 位置（进度条的值）
+ */
+void graphicsView::handleSeek(qint64 position)
+{
+    if(enterReplay())
+        scheduler->seek(std::size_t(qMax<qint64>(position, 0)));
+}
+
+void graphicsView::handleStepForward()
+{
+    if(enterReplay())
+        scheduler->stepForward();
+}
+
+void graphicsView::handleStepBackward()
+{
+    if(enterReplay())
+        scheduler->stepBackward();
+}
+
+/**
+ * @brief graphicsView::handleTraversalFinished 动画播放完毕
+ */
+void graphicsView::handleTraversalFinished()
+{
+    // 所有结点的访问次数奇偶相同，以根结点的颜色为准
+    currentVexColor = vexes.front()->brush().color();
+    emit traversalEnd();
+    isTraversal = false;    // 结束遍历，允许添加结点
+}
+
+/**
+ * @brief graphicsView::handleSpeedChanged 调整动画速度
+ * @param stepsPerSecond 每秒播放的步数
+ */
+void graphicsView::handleSpeedChanged(int stepsPerSecond)
+{
+    scheduler->setSpeed(stepsPerSecond);
 }
 
 /**
  * @brief graphicsView::handleModeChanged
- * @param mode 前/中/后序
+ * @param mode 前/中/后序/层序
  */
 void graphicsView::handleModeChanged(int mode)
 {
+    if(mode != traversalMode)
+        isTraceValid = false;
     traversalMode = mode;
-    emit traversalModeChanged(traversalMode, isThreaded);
+    emit traversalModeChanged(traversalMode, traversalMethod);
 }
 
 /**
- * @brief graphicsView::handleThreadStateChanged 处理勾选/取消勾选“thread”
- * @param state 是否线索化
+ * @brief graphicsView::handleMethodChanged 切换遍历方法
+ * @param method 栈/线索/Morris
  */
-void graphicsView::handleThreadStateChanged(int state)
+void graphicsView::handleMethodChanged(int method)
 {
-    isThreaded = state;
-    emit traversalModeChanged(traversalMode, isThreaded);
+    if(method != traversalMethod)
+        isTraceValid = false;
+    traversalMethod = method;
+    emit traversalModeChanged(traversalMode, traversalMethod);
 }
 
 /**
@@ -230,9 +574,35 @@ void graphicsView::handleThreadStateChanged(int state)
  */
 void graphicsView::handleClearCanvas()
 {
-    graphicsScene->clear();
+    // 播放中则只取消动画，恢复结点颜色
+    if(scheduler->isActive()){
+        scheduler->cancel();
+        removeThread();
+        for(qint64 i = 0; i < vexNum; ++i)
+            vexes[i]->setBrush(currentVexColor);
+        emit traversalEnd();
+        isTraversal = false;
+        emit tipsChanged("The traversal is cancelled.");
+        return;
+    }
+
+    // 图元均保留复用：结点隐藏后回到结点池，边与线索只清空几何信息，不释放内存
+    animator->stopAll();
+    for(qint64 i = 0; i < vexNum; ++i)
+        vexes[i]->hide();
+    edges->clear();
+    threads->clear();
+    curEdge->hide();
+    isNewVexCreating = false;
+    setCursor(Qt::ArrowCursor);
+    binTree.setRoot(nullptr);
     vexNum = 0;
-    threads.clear();    // 清空记录的thread，防止再次删除
+    isTreeThreaded = false;
+    isTraceValid = false;
+    scheduler->clear();
+    emit traceProgressChanged(0, 0);
+    aggregateCells.clear();
+    isAggregateDirty = true;
     currentVexColor = defaultVexColor;      // 恢复为默认颜色
     emit leafNodeNumChanged(0);
     emit tipsChanged("Click the canvas to create a root node.");
@@ -241,25 +611,39 @@ void graphicsView::handleClearCanvas()
 
 /* 二叉树结点：graphicsVexItem */
 
-graphicsVexItem::graphicsVexItem(qreal _radius, QPointF _position, QColor _color, QColor _color2, qint16 _id, QGraphicsItem* parent):
+graphicsVexItem::graphicsVexItem(qreal _radius, QPointF _position, QColor _color, QColor _color2, qint64 _id, animationDriver* _animator, QGraphicsItem* parent):
     QGraphicsEllipseItem(_position.x() - _radius, _position.y() - _radius, 2 * _radius, 2 * _radius, parent),
     radius(_radius),
     position(_position),
     color(_color),
     color2(_color2),
     id(_id),
-    name("V" + QString::number(id))
+    animator(_animator)
 {
-    nameTag = new QGraphicsSimpleTextItem(this);
-    nameTag->setPos(position + QPointF(radius, - radius - QFontMetrics(nameFont).height()));
-    nameTag->setFont(nameFont);
-    nameTag->setText(name);
-    nameTag->setZValue(this->zValue());
-    nameTag->setBrush(Qt::transparent);
-    nameTag->setFlags(QGraphicsItem::ItemIsSelectable);
-
     setBrush(this->color);
     setPen(QPen(Qt::NoPen));;
+    setAcceptHoverEvents(true);     // 悬停时显示子树统计信息
+    this->popOutAnimation(true);
+}
+
+/**
+ * @brief graphicsVexItem::reset 复用结点：清空孩子、双亲与统计信息，移动到新位置并重新弹出
+ * @param _position 新的位置
+ * @param _color 颜色
+ * @param _color2 交替的颜色
+ */
+void graphicsVexItem::reset(QPointF _position, QColor _color, QColor _color2)
+{
+    color = _color;
+    color2 = _color2;
+    leftLink.set(nullptr, binaryTreeNode::LINK);
+    rightLink.set(nullptr, binaryTreeNode::LINK);
+    parentNode = nullptr;
+    resetSubtreeStatistics();
+
+    setBrush(this->color);
+    setPosition(_position);
+    nameAlpha = 0;
     this->popOutAnimation(true);
 }
 
@@ -270,50 +654,100 @@ graphicsVexItem::graphicsVexItem(qreal _radius, QPointF _position, QColor _color
 void graphicsVexItem::mousePressEvent(QGraphicsSceneMouseEvent *e)
 {
     bool isLeftChild = (e->button() == Qt::LeftButton);
-    if((isLeftChild && !leftChild) || (!isLeftChild && !rightChild))
+    if((isLeftChild && !leftLink.get()) || (!isLeftChild && !rightLink.get()))
         emit startNewVex(this, isLeftChild);
     this->popOutAnimation(false);
 }
 
+/**
+ * @brief graphicsVexItem::hoverEnterEvent 悬停时显示以该结点为根的子树统计（增量维护，无需遍历）
+ * @param e
+ */
+void graphicsVexItem::hoverEnterEvent(QGraphicsSceneHoverEvent *e)
+{
+    setToolTip(QString("%1\nsubtree size: %2\nheight: %3\nleaf node: %4")
+               .arg(getName())
+               .arg(getSubtreeSize())
+               .arg(getSubtreeHeight())
+               .arg(getSubtreeLeafNum()));
+    QGraphicsEllipseItem::hoverEnterEvent(e);
+}
+
 graphicsVexItem* graphicsVexItem::getLeftChild() const
 {
-    return this->leftChild;
+    return this->leftLink.get();
 }
 
 graphicsVexItem* graphicsVexItem::getRightChild() const
 {
-    return this->rightChild;
+    return this->rightLink.get();
 }
 
 enum binaryTreeNode::TAG graphicsVexItem::getLeftChildTag() const
 {
-    return this->leftChildTag;
+    return this->leftLink.tag();
 }
 
 enum binaryTreeNode::TAG graphicsVexItem::getRightChildTag() const
 {
-    return this->rightChildTag;
+    return this->rightLink.tag();
+}
+
+// 孩子与标记存放在同一个字中，一次读取
+graphicsVexItem* graphicsVexItem::getLeftLink(enum binaryTreeNode::TAG& tag) const
+{
+    taggedLink<graphicsVexItem> link = this->leftLink;
+    tag = link.tag();
+    return link.get();
+}
+
+graphicsVexItem* graphicsVexItem::getRightLink(enum binaryTreeNode::TAG& tag) const
+{
+    taggedLink<graphicsVexItem> link = this->rightLink;
+    tag = link.tag();
+    return link.get();
+}
+
+graphicsVexItem* graphicsVexItem::getParentNode() const
+{
+    return this->parentNode;
 }
 
 void graphicsVexItem::setLeftChild(binaryTreeNode* _leftChild, enum binaryTreeNode::TAG tag)
 {
-    this->leftChild = dynamic_cast<graphicsVexItem *>(_leftChild);
-    this->leftChildTag = tag;
-    // qDebug() << "set" << (leftChild ? leftChild->name : "null") << "as the left" << (tag == binaryTreeNode::LINK ? "link" : "thread") << "of"<<name;
-    emit startNewThread(this, leftChild, THREAD_POSITION::LEFT);
+    this->leftLink.set(static_cast<graphicsVexItem *>(_leftChild), tag);    // 同一棵树中的结点均为graphicsVexItem
+    // qDebug() << "set" << (leftLink.get() ? leftLink.get()->name : "null") << "as the left" << (tag == binaryTreeNode::LINK ? "link" : "thread") << "of"<<name;
+    if(tag == binaryTreeNode::THREAD)
+        emit startNewThread(this, leftLink.get(), THREAD_POSITION::LEFT);
 }
 
 void graphicsVexItem::setRightChild(binaryTreeNode* _rightChild, enum binaryTreeNode::TAG tag)
 {
-    this->rightChild = dynamic_cast<graphicsVexItem *>(_rightChild);
-    this->rightChildTag = tag;
-    // qDebug() << "set" << (rightChild ? rightChild->name : "null") << "as the right" << (tag == binaryTreeNode::LINK ? "link" : "thread") << "of"<<name;
-    emit startNewThread(this, rightChild, THREAD_POSITION::RIGHT);
+    this->rightLink.set(static_cast<graphicsVexItem *>(_rightChild), tag);
+    // qDebug() << "set" << (rightLink.get() ? rightLink.get()->name : "null") << "as the right" << (tag == binaryTreeNode::LINK ? "link" : "thread") << "of"<<name;
+    if(tag == binaryTreeNode::THREAD)
+        emit startNewThread(this, rightLink.get(), THREAD_POSITION::RIGHT);
 }
 
+void graphicsVexItem::setParentNode(binaryTreeNode* _parentNode)
+{
+    this->parentNode = static_cast<graphicsVexItem *>(_parentNode);
+}
+
+/**
+ * @brief graphicsVexItem::visit 遍历算法访问结点，只发出信号记录，动画由调度器播放
+ */
 void graphicsVexItem::visit()
 {
-    // qDebug() << "visit" << name << "(left child" << (leftChild ? leftChild->name : "null") << "right child" << (rightChild ? rightChild->name : "null") << ")";
+    emit visited(this);
+}
+
+/**
+ * @brief graphicsVexItem::playVisit 播放访问动画
+ */
+void graphicsVexItem::playVisit()
+{
+    // qDebug() << "visit" << name << "(left child" << (leftLink.get() ? leftLink.get()->name : "null") << "right child" << (rightLink.get() ? rightLink.get()->name : "null") << ")";
 
     // 高亮与原色来回交替
     if(this->brush() == color)
@@ -323,22 +757,27 @@ void graphicsVexItem::visit()
     this->popOutAnimation();
 }
 
-// 新建结点时的弹出动画
+// 新建结点时的弹出动画（由animationDriver统一驱动）
 void graphicsVexItem::popOutAnimation(bool withNameTag)
 {
-    QTimeLine* timeLine = new QTimeLine(300, this);
-    timeLine->setFrameRange(0, 1000);
-    QEasingCurve curve = QEasingCurve::InBounce;
+    animator->start(this, withNameTag);
+}
 
-    connect(timeLine, &QTimeLine::frameChanged, timeLine, [=](qint16 frame){
-        qreal curProgress = curve.valueForProgress(frame / 1000.0);
-        qreal curRadius = radius + 5 - 5 * curProgress;
-        if(withNameTag)
-            nameTag->setBrush(QColor(0, 0, 0, int(curProgress * 0xFF)));
-        this->setRect(QRectF(position.x() - curRadius, position.y() - curRadius, curRadius * 2, curRadius * 2));
-    });
+/**
+ * @brief graphicsVexItem::applyPopOut 按进度设置弹出动画的一帧
+ * @param progress 线性进度，0为开始，1为结束
+ * @param withNameTag 是否同时淡入名称
+ */
+void graphicsVexItem::applyPopOut(qreal progress, bool withNameTag)
+{
+    static const QEasingCurve timeCurve = QEasingCurve::InOutSine;     // 与原QTimeLine的默认曲线一致
+    static const QEasingCurve curve = QEasingCurve::InBounce;
 
-    timeLine->start();
+    qreal curProgress = curve.valueForProgress(timeCurve.valueForProgress(progress));
+    qreal curRadius = radius + 5 - 5 * curProgress;
+    if(withNameTag)
+        nameAlpha = int(curProgress * 0xFF);
+    this->setRect(QRectF(position.x() - curRadius, position.y() - curRadius, curRadius * 2, curRadius * 2));
 }
 
 // 获取结点半径
@@ -353,30 +792,106 @@ QPointF graphicsVexItem::getPosition() const
     return position;
 }
 
-// 获取结点名字
+// 获取结点名字（首次调用时生成）
 QString graphicsVexItem::getName() const
 {
+    if(name.isEmpty())
+        name = "V" + QString::number(id);
     return name;
 }
 
-graphicsVexItem::~graphicsVexItem()
+// 获取结点编号
+qint64 graphicsVexItem::getId() const
 {
+    return id;
 }
 
+/**
+ * @brief graphicsVexItem::setPosition 移动结点及其名称（相连的边由graphicsEdgeBatchItem统一更新）
+ * @param _position 新的中心位置
+ */
+void graphicsVexItem::setPosition(QPointF _position)
+{
+    // 名称区域随position变化，须在改动之前通知场景，使索引按旧的包围盒移除结点
+    prepareGeometryChange();
+    position = _position;
+    setRect(QRectF(position.x() - radius, position.y() - radius, 2 * radius, 2 * radius));
+}
 
+// 名称标签的字体（所有结点共用）
+const QFont& graphicsVexItem::nameFont()
+{
+    static const QFont font("Corbel", 13, QFont::Normal, true);
+    return font;
+}
 
-/* 二叉树边：graphicsEdgeItem */
+/**
+ * @brief graphicsVexItem::nameRect 名称标签所在的区域（位于结点右上方）
+ *        宽度按编号的位数估计，不需要生成名称
+ */
+QRectF graphicsVexItem::nameRect() const
+{
+    static const QFontMetricsF metrics(nameFont());
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+    static const qreal letterWidth = metrics.horizontalAdvance('V'), digitWidth = metrics.horizontalAdvance('0');
+#else
+    static const qreal letterWidth = metrics.width('V'), digitWidth = metrics.width('0');
+#endif
+    int digitNum = 1;
+    for(qint64 n = id; n >= 10; n /= 10)
+        ++digitNum;
+    return QRectF(position.x() + radius, position.y() - radius - metrics.height(),
+                  letterWidth + digitWidth * digitNum + 2, metrics.height());
+}
+
+/**
+ * @brief graphicsVexItem::setNameVisible 按细节层次显示/隐藏名称
+ * @param visible 是否显示
+ */
+void graphicsVexItem::setNameVisible(bool visible)
+{
+    if(isNameVisible == visible)
+        return;
+    isNameVisible = visible;
+    update();
+}
 
-graphicsEdgeItem::graphicsEdgeItem(graphicsVexItem* start, graphicsVexItem* end, QGraphicsItem* parent):
-    QGraphicsLineItem (QLine(start->getPosition().toPoint(), end->getPosition().toPoint()), parent)
+QRectF graphicsVexItem::boundingRect() const
+{
+    return QGraphicsEllipseItem::boundingRect().united(nameRect());
+}
+
+/**
+ * @brief graphicsVexItem::paint 绘制结点，并在其右上方绘制名称（名称在此时才生成）
+ */
+void graphicsVexItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    QGraphicsEllipseItem::paint(painter, option, widget);
+    if(!isNameVisible || nameAlpha == 0)
+        return;
+    QRectF rect = nameRect();
+    if(!rect.intersects(option->exposedRect))
+        return;
+    painter->setFont(nameFont());
+    painter->setPen(QColor(0, 0, 0, nameAlpha));
+    painter->drawText(rect, Qt::AlignLeft | Qt::AlignVCenter, getName());
+}
+
+graphicsVexItem::~graphicsVexItem()
 {
-    setPen(defaultPen);
+    animator->stop(this);   // 归还动画槽位
 }
 
-graphicsEdgeItem::graphicsEdgeItem(graphicsVexItem* start, QPointF end, QGraphicsItem* parent):
-    QGraphicsLineItem (QLine(start->getPosition().toPoint(), end.toPoint()), parent)
+
+
+/* 二叉树边：graphicsEdgeItem */
+
+graphicsEdgeItem::graphicsEdgeItem(QGraphicsItem* parent):
+    QGraphicsLineItem (parent)
 {
     setPen(defaultDashPen);
+    setZValue(-1);
+    hide();
 }
 
 graphicsEdgeItem::~graphicsEdgeItem()
@@ -384,13 +899,128 @@ graphicsEdgeItem::~graphicsEdgeItem()
 }
 
 
-/* 二叉树线索：graphicsThreadItem */
+/* 二叉树的所有边：graphicsEdgeBatchItem */
+
+graphicsEdgeBatchItem::graphicsEdgeBatchItem(QGraphicsItem* parent):
+    QGraphicsItem (parent)
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);    // 绘制时只画露出区域内的边
+    this->setZValue(-1);
+}
+
+/**
+ * @brief graphicsEdgeBatchItem::addEdge 新增一条边
+ * @param start 双亲
+ * @param end 孩子
+ */
+void graphicsEdgeBatchItem::addEdge(graphicsVexItem* start, graphicsVexItem* end)
+{
+    ends.push_back(qMakePair(start, end));
+    invalidate();
+}
+
+/**
+ * @brief graphicsEdgeBatchItem::invalidate 结点移动后标记几何信息失效，多次调用只通知一次
+ */
+void graphicsEdgeBatchItem::invalidate()
+{
+    if(!isDirty){
+        prepareGeometryChange();
+        isDirty = true;
+    }
+}
 
-graphicsThreadItem::graphicsThreadItem(graphicsVexItem* _start, graphicsVexItem* _end, enum THREAD_POSITION _position, QGraphicsItem* parent):
-    QGraphicsItem (parent),
-    end(_end->getPosition()),
-    position(_position)
+void graphicsEdgeBatchItem::clear()
 {
+    prepareGeometryChange();
+    ends.clear();
+    lines.clear();
+    bounds = QRectF();
+    isDirty = false;
+}
+
+/**
+ * @brief graphicsEdgeBatchItem::rebuild 由结点的当前位置重建所有线段
+ */
+void graphicsEdgeBatchItem::rebuild() const
+{
+    lines.resize(ends.size());
+    qreal minx = 0, miny = 0, maxx = 0, maxy = 0;
+    for(int i = 0; i < ends.size(); ++i){
+        QPointF p1 = ends[i].first->getPosition(), p2 = ends[i].second->getPosition();
+        lines[i] = QLineF(p1, p2);
+        if(i == 0){
+            minx = maxx = p1.x();
+            miny = maxy = p1.y();
+        }
+        minx = qMin(minx, qMin(p1.x(), p2.x()));
+        maxx = qMax(maxx, qMax(p1.x(), p2.x()));
+        miny = qMin(miny, qMin(p1.y(), p2.y()));
+        maxy = qMax(maxy, qMax(p1.y(), p2.y()));
+    }
+    // 为线宽预留空间
+    qreal margin = defaultPen.widthF();
+    bounds = ends.empty() ? QRectF() : QRectF(QPointF(minx, miny), QPointF(maxx, maxy)).adjusted(-margin, -margin, margin, margin);
+    isDirty = false;
+}
+
+QRectF graphicsEdgeBatchItem::boundingRect() const
+{
+    if(isDirty)
+        rebuild();
+    return bounds;
+}
+
+/**
+ * @brief graphicsEdgeBatchItem::shape 空形状：默认形状为整个包围矩形，会遮住树范围内空白处的点击，使拖动画布失效
+ */
+QPainterPath graphicsEdgeBatchItem::shape() const
+{
+    return QPainterPath();
+}
+
+void graphicsEdgeBatchItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    if(isDirty)
+        rebuild();
+
+    painter->setPen(defaultPen);
+    QRectF exposed = option->exposedRect;
+    if(exposed.contains(bounds)){
+        painter->drawLines(lines);
+        return;
+    }
+    // 只画外接矩形与露出区域相交的边（竖直的边外接矩形宽度为0，按线宽放大）
+    qreal margin = defaultPen.widthF();
+    QVector<QLineF> visible;
+    for(const QLineF& line : lines)
+        if(QRectF(line.p1(), line.p2()).normalized().adjusted(-margin, -margin, margin, margin).intersects(exposed))
+            visible.push_back(line);
+    painter->drawLines(visible);
+}
+
+
+/* 二叉树的所有线索：graphicsThreadBatchItem */
+
+graphicsThreadBatchItem::graphicsThreadBatchItem(QGraphicsItem* parent):
+    QGraphicsItem (parent)
+{
+    // 置于最底层
+    this->setZValue(-2);
+}
+
+/**
+ * @brief graphicsThreadBatchItem::addThread 计算一条线索的曲线与箭头并加入缓存
+ * @param _start 当前结点
+ * @param _end 前驱/后继结点
+ * @param position 左/右孩子处
+ */
+void graphicsThreadBatchItem::addThread(graphicsVexItem* _start, graphicsVexItem* _end, enum THREAD_POSITION position)
+{
+    QPointF start, end = _end->getPosition(), controlPoint;
+
     // 设置起始出发点
     if(position == THREAD_POSITION::LEFT)
         start.setX(_start->getPosition().x() - _start->getRadius() * M_SQRT1_2);
@@ -423,44 +1053,75 @@ graphicsThreadItem::graphicsThreadItem(graphicsVexItem* _start, graphicsVexItem*
         controlPoint.setY(middle.y() - deltaY);
     }
 
-    // 置于最底层
-    this->setZValue(-2);
+    // 箭头
+    QPointF arrowSide1 = end + (start - end) / getDistance(start, end) * 40, arrowSide2;
+    qreal rotationAngle = qRadiansToDegrees(60.0);
+    // 逆时针旋转的情况
+    if((position == LEFT && start.y() < end.y()) || (position == RIGHT && start.y() > end.y()))
+        rotationAngle = - rotationAngle;
+    arrowSide2.setX((arrowSide1.x() - end.x()) * cos(rotationAngle) - (arrowSide1.y() - end.y()) * sin(rotationAngle) + end.x());
+    arrowSide2.setY((arrowSide1.x() - end.x()) * sin(rotationAngle) + (arrowSide1.y() - end.y()) * cos(rotationAngle) + end.y());
+
+    prepareGeometryChange();
+    curves.moveTo(start);
+    curves.quadTo(controlPoint, end);
+    arrows.push_back(QLineF(end, arrowSide1));
+    arrows.push_back(QLineF(end, arrowSide2));
+
+    // 曲线位于起点、终点与控制点围成的三角形内，再为线宽预留空间
+    qreal margin = curvePen.widthF();
+    QRectF rect = QRectF(start, end).normalized()
+                  .united(QRectF(controlPoint, controlPoint))
+                  .united(QRectF(arrowSide1, arrowSide2).normalized())
+                  .adjusted(-margin, -margin, margin, margin);
+    bounds = bounds.isNull() ? rect : bounds.united(rect);
+}
+
+void graphicsThreadBatchItem::clear()
+{
+    prepareGeometryChange();
+    curves = QPainterPath();
+    arrows.clear();
+    bounds = QRectF();
 }
 
-QRectF graphicsThreadItem::boundingRect() const
+bool graphicsThreadBatchItem::isEmpty() const
 {
-    // 为箭头预留空间
-    qreal minx = qMin(start.x(), qMin(end.x(), controlPoint.x())) - 50;
-    qreal maxx = qMax(start.x(), qMax(end.x(), controlPoint.x())) + 50;
-    qreal miny = qMin(start.y(), qMin(end.y(), controlPoint.y())) - 50;
-    qreal maxy = qMax(start.y(), qMax(end.y(), controlPoint.y())) + 50;
-    return QRectF(QPointF(minx, miny), QPointF(maxx, maxy));
+    return arrows.empty();
 }
 
-void graphicsThreadItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+std::size_t graphicsThreadBatchItem::size() const
+{
+    return std::size_t(arrows.size() / 2);     // 每条线索两段箭头
+}
+
+QRectF graphicsThreadBatchItem::boundingRect() const
+{
+    return bounds;
+}
+
+QPainterPath graphicsThreadBatchItem::shape() const
+{
+    return QPainterPath();
+}
+
+void graphicsThreadBatchItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
-    // 画弧线
-    QPainterPath painterPath;
-    painter->setPen(QPen(QColor(144, 200, 180, 64), 3, Qt::DashLine));
-    painterPath.moveTo(start);
-    painterPath.quadTo(controlPoint, end);
-
-    painter->drawPath(painterPath);
+    painter->setPen(curvePen);
+    painter->drawPath(curves);
+    painter->setPen(arrowPen);
+    painter->drawLines(arrows);
+}
 
-    // 画箭头
-    painter->setPen(QPen(QColor(144, 200, 180, 64), 3, Qt::SolidLine));
-    QPointF arrowSide1 = end + (start - end) / getDistance(start, end) * 40, arrowSide2;
-    qreal rotationAngle = qRadiansToDegrees(60.0);
-    // 逆时针旋转的情况
-    if((position == LEFT && start.y() < end.y()) || (position == RIGHT && start.y() > end.y()))
-        rotationAngle = - rotationAngle;
-    arrowSide2.setX((arrowSide1.x() - end.x()) * cos(rotationAngle) - (arrowSide1.y() - end.y()) * sin(rotationAngle) + end.x());
-    arrowSide2.setY((arrowSide1.x() - end.x()) * sin(rotationAngle) + (arrowSide1.y() - end.y()) * cos(rotationAngle) + end.y());
-    painter->drawLine(end, arrowSide1);
-    painter->drawLine(end, arrowSide2);
+/**
+ * @brief vexIndex::operator() 结点编号，供布局按编号存放数据
+ */
+std::size_t vexIndex::operator()(binaryTreeNode* n) const
+{
+    return std::size_t(static_cast<graphicsVexItem*>(n)->getId());
 }
 
 /**
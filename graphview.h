@@ -4,9 +4,15 @@
 #include <QGraphicsScene>
 #include <QGraphicsItem>
 #include <QGraphicsSceneMouseEvent>
+#include <QGraphicsSceneHoverEvent>
 #include <QComboBox>
 #include <QMouseEvent>
-#include <QTimeLine>
+#include <QWheelEvent>
+#include <QScrollBar>
+#include <QHash>
+#include <QPainterPath>
+#include <QStyleOptionGraphicsItem>
+#include <QEasingCurve>
 #include <QPainter>
 #include <QBrush>
 #include <QVector>
@@ -16,6 +22,10 @@
 #include <QDebug>
 #include <QtMath>
 #include "binarytree.h"
+#include "taggednode.h"
+#include "stepscheduler.h"
+#include "animationdriver.h"
+#include "tidylayout.h"
 
 // 二叉树显示的画布
 class graphicsView;
@@ -23,39 +33,83 @@ class graphicsView;
 // 二叉树的可视化结点
 class graphicsVexItem;
 
-// 二叉树的可视化边
+// 二叉树的可视化边（拖动中的边）
 class graphicsEdgeItem;
 
-// 二叉树的可视化（线索）线
-class graphicsThreadItem;
+// 二叉树的所有边（合并绘制）
+class graphicsEdgeBatchItem;
+
+// 二叉树的所有线索（合并绘制）
+class graphicsThreadBatchItem;
 
 // 线索是左还是右结点（用于绘制）
 enum THREAD_POSITION  { LEFT, RIGHT };
 
+// 布局数据按结点编号存放
+struct vexIndex
+{
+    std::size_t operator()(binaryTreeNode* n) const;
+};
+
 
 // 二叉树显示的画布
 class graphicsView: public QGraphicsView
 {
     Q_OBJECT
 
+public:
+    // 细节层次：完整 / 简化（无名称、线索与动画）/ 聚合（密集区域合并为色块）
+    enum LEVEL_OF_DETAIL { DETAIL, SIMPLE, AGGREGATE };
+
 private:          
     // 画布基础信息
-    qint16 leftTopx, leftTopy;
-    qint16 width, height;
+    int leftTopx, leftTopy;
+    int width, height;
     QGraphicsScene* graphicsScene;
 
-    binaryTree* binTree = nullptr;
-    qint16 vexNum = 0;                  // 已有的结点数量
+    binaryTree binTree;                 // 画布上的二叉树（为空时根结点为空）
+    qint64 vexNum = 0;                  // 已有的结点数量
     bool isNewVexCreating = false;      // 是否在创建新的结点
-    bool isTraversal = false;           // 是否正在遍历（此时禁止拖拽）
+    bool isTraversal = false;           // 是否正在播放遍历动画（此时禁止拖拽）
+    bool isTreeThreaded = false;        // 树的结构是否已线索化（画面上的线索可能因跳转而未画出）
     bool isLeftChild;                   // 是否创建的是左子树（左键左子树，右键右子树）
     graphicsVexItem* curParentNode;     // 若在创建新的结点，则要记录其双亲
-    graphicsEdgeItem* curEdge;          // 拖动时绘制的边
+    graphicsEdgeItem* curEdge;          // 拖动时绘制的边（复用同一个图元）
 
     int traversalMode = 0;                  // 遍历模式
-    bool isThreaded = false;                // 是否线索化
-    QVector<graphicsThreadItem *> threads;  // 存储所有线索以单独清除
+    int traversalMethod = binaryTree::STACK_TRAVERSAL;  // 遍历方法：栈/线索/Morris
+    bool isThreadRecorded = true;           // 是否记录并绘制新建的线索（Morris的临时线索不绘制）
+    graphicsEdgeBatchItem* edges;           // 所有的边
+    graphicsThreadBatchItem* threads;       // 所有的线索
+    std::vector<graphicsVexItem *> vexes;   // 结点池：前vexNum个在使用中，其余隐藏待复用（下标即编号）
     QColor currentVexColor;                 // 当前的颜色（交替）
+    stepScheduler* scheduler;               // 遍历动画的调度器
+    bool isTraceValid = false;              // 已记录的轨迹是否仍适用（树与遍历模式未变）
+    std::vector<std::uint64_t> traceStartParity;    // 记录轨迹时各结点是否为第二种颜色
+    std::vector<std::uint64_t> seekParity;          // 跳转时的缓冲
+    animationDriver* animator;              // 结点动画的统一驱动
+    tidyLayout<virtualNodeAccess, vexIndex> layout;     // 自动布局
+    QPointF layoutOrigin;                   // 根结点的位置（布局原点）
+
+    // 缩放与平移
+    LEVEL_OF_DETAIL levelOfDetail = DETAIL;
+    bool isPanning = false;                 // 是否正在拖动画布
+    QPoint panStart;                        // 上一次拖动的位置
+
+    // 聚合显示：按格子统计结点数，格子边长为2的幂，缩放时少重建
+    struct aggregateCell
+    {
+        QRectF rect;
+        qint64 vexNum;
+    };
+    QVector<aggregateCell> aggregateCells;
+    qreal aggregateCellSize = 0;            // 当前缓存对应的格子边长（场景坐标）
+    bool isAggregateDirty = true;           // 结点增加或移动后需重建
+
+    bool enterReplay();
+    void updateLevelOfDetail();
+    void applyLevelOfDetail(graphicsVexItem* vex);
+    void rebuildAggregate(qreal cellSize);
 
     // 默认配置
     const QColor defaultVexColor;
@@ -65,24 +119,40 @@ private:
 protected:
     void mousePressEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
     void mouseMoveEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void mouseReleaseEvent(QMouseEvent *e) Q_DECL_OVERRIDE;
+    void wheelEvent(QWheelEvent *e) Q_DECL_OVERRIDE;
+    void drawForeground(QPainter *painter, const QRectF &rect) Q_DECL_OVERRIDE;
 
 public:
-    graphicsView(qint16 _leftTopx = 0, qint16 _leftTopy = 0, qint16 _width = 780, qint16 _height = 640, QWidget* parent = nullptr);
+    graphicsView(int _leftTopx = 0, int _leftTopy = 0, int _width = 780, int _height = 640, QWidget* parent = nullptr);
     ~graphicsView() Q_DECL_OVERRIDE;
     graphicsVexItem* addVex(QPointF position);
     void removeThread();
+    void moveVex(binaryTreeNode* node, float x, float y);
+    void drawThread(graphicsVexItem* start, graphicsVexItem* end, enum THREAD_POSITION position);
     void handleNewVexCreate(graphicsVexItem* parentNode, bool _isLeftChild);
     void handleNewThreadCreate(graphicsVexItem* start, graphicsVexItem* end, enum THREAD_POSITION position);
+    void handleVexVisited(graphicsVexItem* vex);
     void handleStartTraversal();
+    void handleStep(const traversalStep& step);
+    void handleTraversalFinished();
+    void handleSeeked(std::size_t position);
+    void handleSeek(qint64 position);
+    void handleStepForward();
+    void handleStepBackward();
+    void handleSpeedChanged(int stepsPerSecond);
     void handleModeChanged(int mode = 0);
-    void handleThreadStateChanged(int state);
+    void handleMethodChanged(int method);
     void handleClearCanvas();
 
 signals:
     void tipsChanged(const QString& tipsContent);
-    void leafNodeNumChanged(qint16 leafNodeNum);
-    void traversalModeChanged(int traverseOrder, bool isThreaded);
+    void leafNodeNumChanged(qint64 leafNodeNum);
+    void metricsChanged(const traversalMetrics& metrics);
+    void traceProgressChanged(qint64 position, qint64 length);
+    void traversalModeChanged(int traverseOrder, int method);
     void traversalStart();
+    void traversalPaused(bool isPaused);
     void traversalEnd();
 };
 
@@ -93,6 +163,7 @@ class graphicsVexItem: public QObject, public QGraphicsEllipseItem, public binar
     Q_OBJECT
 
     friend class graphicsView;
+    friend class animationDriver;
 
 private:
     // 基础信息
@@ -100,26 +171,37 @@ private:
     QPointF position;
     QColor color, color2;   // 两种颜色交替
 
-    // 编号与名称
-    qint16 id;  // 结点的编号（唯一）
-    QString name;
+    // 编号与名称（名称在首次绘制或查询时才生成）
+    qint64 id;  // 结点的编号（唯一）
+    mutable QString name;
 
-    // NameTag
-    QGraphicsSimpleTextItem* nameTag;
-    QFont nameFont = QFont("Corbel", 13, QFont::Normal, true);
+    // 名称标签：直接在paint()中绘制，不另建图元
+    bool isNameVisible = true;
+    int nameAlpha = 0;          // 名称的不透明度（弹出动画中淡入）
+    static const QFont& nameFont();
+    QRectF nameRect() const;
+    void setNameVisible(bool visible);
+
+    // 弹出动画
+    animationDriver* animator;
+    int animationSlot = -1;     // 进行中的动画所在的槽位
+    void applyPopOut(qreal progress, bool withNameTag);
 
-    // 左右孩子及tag
-    graphicsVexItem* leftChild = nullptr, * rightChild = nullptr;
-    enum binaryTreeNode::TAG leftChildTag = binaryTreeNode::LINK;
-    enum binaryTreeNode::TAG rightChildTag = binaryTreeNode::LINK;
+    // 左右孩子及tag，以及双亲
+    taggedLink<graphicsVexItem> leftLink, rightLink;   // 标记存放在孩子指针的最低位
+    graphicsVexItem* parentNode = nullptr;
 
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *e) Q_DECL_OVERRIDE;
+    void hoverEnterEvent(QGraphicsSceneHoverEvent *e) Q_DECL_OVERRIDE;
 
 public:
-    graphicsVexItem(qreal _radius, QPointF _position, QColor _color, QColor _color2, qint16 _id, QGraphicsItem* parent = nullptr);
+    graphicsVexItem(qreal _radius, QPointF _position, QColor _color, QColor _color2, qint64 _id, animationDriver* _animator, QGraphicsItem* parent = nullptr);
     ~graphicsVexItem() Q_DECL_OVERRIDE;
 
+    // 从结点池中取出复用时，恢复为新结点的状态
+    void reset(QPointF _position, QColor _color, QColor _color2);
+
     // 弹出动画
     void popOutAnimation(bool withNameTag = false);
 
@@ -127,23 +209,40 @@ public:
     qreal getRadius() const;
     QPointF getPosition() const;
     QString getName() const;
+    qint64 getId() const;
+
+    // 移动结点，并更新相连的边
+    void setPosition(QPointF _position);
+
+    // 包含名称标签的区域
+    virtual QRectF boundingRect() const Q_DECL_OVERRIDE;
+    virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) Q_DECL_OVERRIDE;
 
     // 对基类虚方法的继承
     virtual graphicsVexItem* getLeftChild() const Q_DECL_OVERRIDE;
     virtual graphicsVexItem* getRightChild() const Q_DECL_OVERRIDE;
     virtual enum TAG getLeftChildTag() const Q_DECL_OVERRIDE;
     virtual enum TAG getRightChildTag() const Q_DECL_OVERRIDE;
+    virtual graphicsVexItem* getLeftLink(enum TAG& tag) const Q_DECL_OVERRIDE;
+    virtual graphicsVexItem* getRightLink(enum TAG& tag) const Q_DECL_OVERRIDE;
+    virtual graphicsVexItem* getParentNode() const Q_DECL_OVERRIDE;
     virtual void setLeftChild(binaryTreeNode* leftChild, enum binaryTreeNode::TAG tag) Q_DECL_OVERRIDE;
     virtual void setRightChild(binaryTreeNode* rightChild, enum binaryTreeNode::TAG tag) Q_DECL_OVERRIDE;
+    virtual void setParentNode(binaryTreeNode* parentNode) Q_DECL_OVERRIDE;
     virtual void visit() Q_DECL_OVERRIDE;
 
+    // 播放一次访问动画
+    void playVisit();
+
 signals:
+    void visited(graphicsVexItem* vex);
     void startNewVex(graphicsVexItem* parentNode, bool isLeftChild);
     void startNewThread(graphicsVexItem* start, graphicsVexItem* end, enum THREAD_POSITION position);
 };
 
 
-// 二叉树的可视化边
+// 二叉树的可视化边（拖动新结点时的虚线，新结点建立后并入graphicsEdgeBatchItem）
+// 画布只创建一个，拖动时显示，结束后隐藏
 class graphicsEdgeItem: public QObject, public QGraphicsLineItem
 {
     Q_OBJECT
@@ -151,35 +250,64 @@ class graphicsEdgeItem: public QObject, public QGraphicsLineItem
     friend class graphicsView;
 
     QPointF start, end;
-    const QPen defaultPen = QPen(QColor(0xB8BBC1), 2, Qt::SolidLine, Qt::RoundCap);
     const QPen defaultDashPen = QPen(QColor(0xD0D2D7), 2, Qt::DashLine, Qt::RoundCap);
 
 public:
-    graphicsEdgeItem(graphicsVexItem* start, graphicsVexItem* end, QGraphicsItem* parent = nullptr);
-    graphicsEdgeItem(graphicsVexItem* start, QPointF end, QGraphicsItem* parent = nullptr);
+    explicit graphicsEdgeItem(QGraphicsItem* parent = nullptr);
     ~graphicsEdgeItem();
 };
 
 
-// 二叉树的可视化（线索）线
-class graphicsThreadItem: public QObject, public QGraphicsItem
+// 二叉树的所有边，合并为一个图元绘制
+// 只记录边的两端结点，结点移动后标记失效，下次绘制前统一重建线段
+class graphicsEdgeBatchItem: public QGraphicsItem
 {
-    Q_OBJECT
-    Q_INTERFACES(QGraphicsItem)
+public:
+    explicit graphicsEdgeBatchItem(QGraphicsItem* parent = nullptr);
 
-    friend class graphicsView;
+    void addEdge(graphicsVexItem* start, graphicsVexItem* end);
+    void invalidate();      // 结点移动后调用
+    void clear();
+
+    virtual QRectF boundingRect() const Q_DECL_OVERRIDE;
+    virtual QPainterPath shape() const Q_DECL_OVERRIDE;     // 不接收鼠标，空白处的点击穿透到画布
+    virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) Q_DECL_OVERRIDE;
+
+private:
+    QVector<QPair<graphicsVexItem*, graphicsVexItem*> > ends;
+    const QPen defaultPen = QPen(QColor(0xB8BBC1), 2, Qt::SolidLine, Qt::RoundCap);
 
+    // 缓存的几何信息
+    mutable QVector<QLineF> lines;
+    mutable QRectF bounds;
+    mutable bool isDirty = false;
+
+    void rebuild() const;
+};
+
+
+// 二叉树的所有线索，合并为一个图元绘制
+// 每条线索的曲线与箭头在加入时计算一次，绘制时直接使用
+class graphicsThreadBatchItem: public QGraphicsItem
+{
 public:
-    graphicsThreadItem(graphicsVexItem* _start, graphicsVexItem* _end, enum THREAD_POSITION position, QGraphicsItem* parent = nullptr);
-    // 必须继承的虚方法
+    explicit graphicsThreadBatchItem(QGraphicsItem* parent = nullptr);
+
+    void addThread(graphicsVexItem* start, graphicsVexItem* end, enum THREAD_POSITION position);
+    void clear();
+    bool isEmpty() const;
+    std::size_t size() const;   // 线索数
+
     virtual QRectF boundingRect() const Q_DECL_OVERRIDE;
+    virtual QPainterPath shape() const Q_DECL_OVERRIDE;     // 不接收鼠标
     virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) Q_DECL_OVERRIDE;
 
 private:
-    // 起始终止位置，以及贝塞尔曲线的控制点
-    QPointF start, end, controlPoint;
-    // 线索是左/右
-    enum THREAD_POSITION position;
+    QPainterPath curves;        // 所有线索的曲线
+    QVector<QLineF> arrows;     // 所有箭头的两条边
+    QRectF bounds;
+    const QPen curvePen = QPen(QColor(144, 200, 180, 64), 3, Qt::DashLine);
+    const QPen arrowPen = QPen(QColor(144, 200, 180, 64), 3, Qt::SolidLine);
 };
 
 
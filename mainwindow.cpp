@@ -1,6 +1,9 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 #include "graphview.h"
+#include <QFileDialog>
+#include <QFile>
+#include <QtMath>
 
 MainWindow::MainWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -26,8 +29,11 @@ MainWindow::MainWindow(QWidget *parent) :
     view->show();
     connect(view, &graphicsView::tipsChanged, this, &MainWindow::handleTipsChanged);
     connect(view, &graphicsView::leafNodeNumChanged, this, &MainWindow::handleLeafNodeNumChanged);
+    connect(view, &graphicsView::metricsChanged, this, &MainWindow::handleMetricsChanged);
+    connect(view, &graphicsView::traceProgressChanged, this, &MainWindow::handleTraceProgressChanged);
     connect(view, &graphicsView::traversalModeChanged, this, &MainWindow::handleTraversalModeChanged);
     connect(view, &graphicsView::traversalStart, this, &MainWindow::handleTraversalStart);
+    connect(view, &graphicsView::traversalPaused, this, &MainWindow::handleTraversalPaused);
     connect(view, &graphicsView::traversalEnd, this, &MainWindow::handleTraversalEnd);
 
     // 右侧栏
@@ -52,6 +58,16 @@ MainWindow::MainWindow(QWidget *parent) :
     labelLeafNodeNumContent = new QLabel("0");
     labelLeafNodeNumContent->setStyleSheet("max-height: 80px; font-size:40px; font-family:'corbel light';");
 
+    labelMetricsContent = new QLabel("No traversal yet.");
+    labelMetricsContent->setWordWrap(true);
+    labelMetricsContent->setAlignment(Qt::AlignTop);
+    labelMetricsContent->setStyleSheet("max-height: 110px; font-size:16px; font-family:'corbel light';");
+    buttonExportMetrics = new QPushButton("Export");
+    buttonExportMetrics->setStyleSheet("min-height:30px; border-radius:8px; font-size:18px; font-family:'corbel'; background-color:rgba(144, 200, 180, 0.5);");
+    buttonExportMetrics->setCursor(Qt::PointingHandCursor);
+    buttonExportMetrics->setEnabled(false);
+    connect(buttonExportMetrics, &QPushButton::clicked, this, &MainWindow::handleExportMetrics);
+
     QLabel* labelSettings = new QLabel("Settings");
     labelSettings->setStyleSheet(headingStyle);
     QLabel* labelOrder = new QLabel("order");
@@ -62,19 +78,54 @@ MainWindow::MainWindow(QWidget *parent) :
     comboBox->addItem("Preorder Traversal");
     comboBox->addItem("Inorder Traversal");
     comboBox->addItem("Postorder Traversal");
+    comboBox->addItem("Level-order Traversal");
     comboBox->setView(new QListView());
     setStyleSheet("QComboBox QAbstractItemView::item{height:30px;}");
     connect(comboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated), view, &graphicsView::handleModeChanged);
 
-    buttonStart = new QPushButton(QString("Start Traversal"));
+    QLabel* labelSpeed = new QLabel("speed");
+    labelSpeed->setStyleSheet("font-size:22px; font-family:'corbel';");
+    QSlider* sliderSpeed = new QSlider(Qt::Horizontal);
+    sliderSpeed->setRange(0, 40);      // 每秒播放2^(value/4)步，即1~1024步
+    sliderSpeed->setValue(4);
+    sliderSpeed->setCursor(Qt::PointingHandCursor);
+    connect(sliderSpeed, &QSlider::valueChanged, view, [view](int value){
+        view->handleSpeedChanged(qRound(qPow(2.0, value / 4.0)));
+    });
+
+    // 回放进度：拖动跳转，两侧按钮单步后退/前进
+    QString stepButtonStyle = "min-height:36px; max-width:40px; border-radius:8px; font-size:22px; font-family:'corbel'; background-color:rgba(144, 200, 180, 0.5);";
+    QPushButton* buttonStepBackward = new QPushButton("<");
+    buttonStepBackward->setStyleSheet(stepButtonStyle);
+    buttonStepBackward->setCursor(Qt::PointingHandCursor);
+    connect(buttonStepBackward, &QPushButton::clicked, view, &graphicsView::handleStepBackward);
+    QPushButton* buttonStepForward = new QPushButton(">");
+    buttonStepForward->setStyleSheet(stepButtonStyle);
+    buttonStepForward->setCursor(Qt::PointingHandCursor);
+    connect(buttonStepForward, &QPushButton::clicked, view, &graphicsView::handleStepForward);
+    sliderProgress = new QSlider(Qt::Horizontal);
+    sliderProgress->setRange(0, 0);
+    sliderProgress->setCursor(Qt::PointingHandCursor);
+    connect(sliderProgress, &QSlider::valueChanged, view, [this, view](int value){
+        int range = sliderProgress->maximum();
+        view->handleSeek(range ? qint64(double(value) * traceLength / range) : 0);
+    });
+
+    buttonStart = new QPushButton(buttonStartText);
     buttonStart->setStyleSheet(buttonStyle);
     buttonStart->setCursor(Qt::PointingHandCursor);
     connect(buttonStart, &QPushButton::clicked, view, &graphicsView::handleStartTraversal);
 
-    QLabel* labelThreaded = new QLabel("thread");
-    labelThreaded->setStyleSheet("font-size:22px; font-family:'corbel';");
-    QCheckBox* checkBox = new QCheckBox();
-    connect(checkBox, &QCheckBox::stateChanged, view, &graphicsView::handleThreadStateChanged);
+    // 遍历方法，顺序与binaryTree::TRAVERSAL_METHOD一致
+    QLabel* labelMethod = new QLabel("method");
+    labelMethod->setStyleSheet("font-size:22px; font-family:'corbel';");
+    QComboBox* comboBoxMethod = new QComboBox();
+    comboBoxMethod->setStyleSheet("min-height:50px; font-size:22px; font-family:'corbel light';");
+    comboBoxMethod->addItem("Stack");
+    comboBoxMethod->addItem("Threaded");
+    comboBoxMethod->addItem("Morris");
+    comboBoxMethod->setView(new QListView());
+    connect(comboBoxMethod, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated), view, &graphicsView::handleMethodChanged);
 
     buttonClear = new QPushButton(QString("Clear"));
     buttonClear->setCursor(Qt::PointingHandCursor);
@@ -85,13 +136,20 @@ MainWindow::MainWindow(QWidget *parent) :
     layOut->addWidget(labelTipsContent, 1, 0, 1, 4);
     layOut->addWidget(labelLeafNode, 2, 0, 1, 3);
     layOut->addWidget(labelLeafNodeNumContent, 2, 3, 1, 2);
-    layOut->addWidget(labelSettings, 3, 0, 1, 4);
-    layOut->addWidget(labelOrder, 4, 0, 1, 1);
-    layOut->addWidget(comboBox, 4, 1, 1, 3);
-    layOut->addWidget(labelThreaded, 5, 0, 1, 1);
-    layOut->addWidget(checkBox, 5, 1, 1, 1);
-    layOut->addWidget(buttonStart, 6, 0, 1, 4);
-    layOut->addWidget(buttonClear, 7, 0, 1, 4);
+    layOut->addWidget(labelMetricsContent, 3, 0, 1, 3);
+    layOut->addWidget(buttonExportMetrics, 3, 3, 1, 1, Qt::AlignTop);
+    layOut->addWidget(labelSettings, 4, 0, 1, 4);
+    layOut->addWidget(labelOrder, 5, 0, 1, 1);
+    layOut->addWidget(comboBox, 5, 1, 1, 3);
+    layOut->addWidget(labelMethod, 6, 0, 1, 1);
+    layOut->addWidget(comboBoxMethod, 6, 1, 1, 3);
+    layOut->addWidget(labelSpeed, 7, 0, 1, 1);
+    layOut->addWidget(sliderSpeed, 7, 1, 1, 3);
+    layOut->addWidget(buttonStepBackward, 8, 0, 1, 1);
+    layOut->addWidget(sliderProgress, 8, 1, 1, 2);
+    layOut->addWidget(buttonStepForward, 8, 3, 1, 1);
+    layOut->addWidget(buttonStart, 9, 0, 1, 4);
+    layOut->addWidget(buttonClear, 10, 0, 1, 4);
     rightBar->setLayout(layOut);
 
     QIcon minIcon(":image/minimize.png");
@@ -152,33 +210,108 @@ void MainWindow::handleTipsChanged(const QString& tips)
     labelTipsContent->setText(tips);
 }
 
-void MainWindow::handleLeafNodeNumChanged(qint16 leafNode)
+void MainWindow::handleLeafNodeNumChanged(qint64 leafNode)
 {
     labelLeafNodeNumContent->setText(QString::number(leafNode));
 }
 
-void MainWindow::handleTraversalModeChanged(int traverseOrder, bool isThreaded)
+/**
+ * @brief MainWindow::handleMetricsChanged 显示上一次遍历的统计信息
+ * @param metrics 线索化与遍历的计数及耗时
+ */
+void MainWindow::handleMetricsChanged(const traversalMetrics& metrics)
+{
+    const traversalCounters& c = metrics.counters;
+    QString text = QString("visited %1, push/pop %2/%3, peak depth %4\n"
+                           "null sentinels %5, threads followed %6, threading %7\n"
+                           "threading %8 ms, traversal %9 ms")
+            .arg(c.visitedNum).arg(c.pushNum).arg(c.popNum).arg(c.peakStackDepth)
+            .arg(c.nullSentinelNum).arg(c.threadFollowedNum).arg(c.threadingNum)
+            .arg(metrics.phaseNanoseconds[traversalMetrics::THREADING_PHASE] / 1e6, 0, 'f', 3)
+            .arg(metrics.phaseNanoseconds[traversalMetrics::TRAVERSAL_PHASE] / 1e6, 0, 'f', 3);
+    if(!metrics.levels.empty()){
+        // 层序遍历：给出层数与最耗时的一层
+        std::size_t slowest = 0;
+        for(std::size_t i = 1; i < metrics.levels.size(); ++i)
+            if(metrics.levels[i].nanoseconds > metrics.levels[slowest].nanoseconds)
+                slowest = i;
+        text += QString("\n%1 levels, slowest level %2 (%3 nodes, %4 ms)")
+                .arg(metrics.levels.size()).arg(slowest).arg(metrics.levels[slowest].width)
+                .arg(metrics.levels[slowest].nanoseconds / 1e6, 0, 'f', 3);
+    }
+    labelMetricsContent->setText(text);
+
+    static const char* orderNames[] = { "preorder", "inorder", "postorder", "levelorder" };
+    static const char* methodNames[] = { "stack", "threaded", "morris" };
+    metricsJson = QString("{\"order\":\"%1\",\"method\":\"%2\",\"threaded\":%3,\"metrics\":%4}\n")
+            .arg(orderNames[traversalOrder])
+            .arg(methodNames[traversalMethod])
+            .arg(isTraversalThreaded ? "true" : "false")
+            .arg(QString::fromStdString(metrics.toJson()));
+    buttonExportMetrics->setEnabled(true);
+}
+
+/**
+ * @brief MainWindow::handleTraceProgressChanged 回放进度变化时更新进度条（不触发跳转）
+ * @param position 当前位置
+ * @param length 轨迹长度
+ */
+void MainWindow::handleTraceProgressChanged(qint64 position, qint64 length)
+{
+    static const qint64 maxRange = 1 << 30;
+    QSignalBlocker blocker(sliderProgress);
+    traceLength = length;
+    int range = int(qMin(length, maxRange));
+    sliderProgress->setRange(0, range);
+    sliderProgress->setValue(length ? int(double(position) * range / length) : 0);
+}
+
+/**
+ * @brief MainWindow::handleExportMetrics 将上一次遍历的统计信息导出为JSON文件
+ */
+void MainWindow::handleExportMetrics()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Export Metrics", "metrics.json", "JSON (*.json)");
+    if(path.isEmpty())
+        return;
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)){
+        handleTipsChanged("Cannot write " + path + ".");
+        return;
+    }
+    file.write(metricsJson.toUtf8());
+}
+
+void MainWindow::handleTraversalModeChanged(int traverseOrder, int method)
 {
-    if(!isThreaded)
-        buttonStart->setText("Start Traversal");
-    else if(traverseOrder == binaryTree::POSTORDER_TRAVERSAL)
-        buttonStart->setText("Create Tree");
+    traversalOrder = traverseOrder;
+    // 层序遍历只有队列实现
+    traversalMethod = traverseOrder == binaryTree::LEVELORDER_TRAVERSAL ? int(binaryTree::STACK_TRAVERSAL) : method;
+    isTraversalThreaded = traversalMethod == binaryTree::THREADED_TRAVERSAL;
+    if(!isTraversalThreaded)
+        buttonStartText = "Start Traversal";
     else
-        buttonStart->setText("Create && Traverse");
+        buttonStartText = "Create && Traverse";
+    if(!isTraversal)     // 播放动画时不改变按钮
+        buttonStart->setText(buttonStartText);
 }
 
+// 播放动画时，开始按钮用于暂停/继续，清除按钮用于停止
 void MainWindow::handleTraversalStart()
 {
-    buttonStart->setEnabled(false);
-    buttonClear->setEnabled(false);
-    buttonStart->setCursor(Qt::ForbiddenCursor);
-    buttonClear->setCursor(Qt::ForbiddenCursor);
+    isTraversal = true;
+    buttonStart->setText("Pause");
+    buttonClear->setText("Stop");
+}
+
+void MainWindow::handleTraversalPaused(bool isPaused)
+{
+    buttonStart->setText(isPaused ? "Resume" : "Pause");
 }
 
 void MainWindow::handleTraversalEnd()
 {
-    buttonStart->setEnabled(true);
-    buttonClear->setEnabled(true);
-    buttonStart->setCursor(Qt::PointingHandCursor);
-    buttonClear->setCursor(Qt::PointingHandCursor);
+    isTraversal = false;
+    buttonStart->setText(buttonStartText);
+    buttonClear->setText("Clear");
 }
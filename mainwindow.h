@@ -8,9 +8,9 @@
 #include <QLabel>
 #include <QGraphicsDropShadowEffect>
 #include <QPushButton>
-#include <QCheckBox>
 #include <QDebug>
 #include <QListView>
+#include <QSlider>
 #include "binarytree.h"
 
 namespace Ui {
@@ -32,9 +32,13 @@ protected:
 
     // 处理graphicView传来的信号
     void handleTipsChanged(const QString& tips);
-    void handleLeafNodeNumChanged(qint16 leafNode);
-    void handleTraversalModeChanged(int traverseOrder, bool isThreaded);
+    void handleLeafNodeNumChanged(qint64 leafNode);
+    void handleMetricsChanged(const traversalMetrics& metrics);
+    void handleExportMetrics();
+    void handleTraceProgressChanged(qint64 position, qint64 length);
+    void handleTraversalModeChanged(int traverseOrder, int method);
     void handleTraversalStart();
+    void handleTraversalPaused(bool isPaused);
     void handleTraversalEnd();
 
 private:
@@ -48,7 +52,17 @@ private:
     // 右侧栏的控件
     QLabel* labelTipsContent;           // 提示信息内容
     QLabel* labelLeafNodeNumContent;    // 叶子结点个数
+    QLabel* labelMetricsContent;        // 上一次遍历的统计信息
+    QPushButton* buttonExportMetrics;
+    QString metricsJson;                // 上一次遍历的统计信息（JSON）
     QPushButton* buttonStart, * buttonClear;
+    QSlider* sliderProgress;            // 回放进度
+    qint64 traceLength = 0;             // 轨迹长度（超过进度条的范围时按比例换算）
+    QString buttonStartText = "Start Traversal";   // 空闲时开始按钮的文字
+    bool isTraversal = false;                       // 是否正在播放遍历动画
+    int traversalOrder = 0;                         // 当前的遍历顺序与方法（导出统计信息时记录）
+    int traversalMethod = binaryTree::STACK_TRAVERSAL;
+    bool isTraversalThreaded = false;
 
 };
 
@@ -0,0 +1,274 @@
+#include "stepscheduler.h"
+
+/**
+ * @brief stepScheduler::stepScheduler
+ * @param interval 每一拍的毫秒数
+ * @param parent 对象树的父亲指针
+ */
+stepScheduler::stepScheduler(int interval, QObject* parent):
+    QObject(parent)
+{
+    timer.setInterval(interval);
+    connect(&timer, &QTimer::timeout, this, &stepScheduler::handleTick);
+}
+
+/**
+ * @brief stepScheduler::clear 丢弃已记录的轨迹
+ * @param nodeNum 之后记录的轨迹中的结点数
+ */
+void stepScheduler::clear(std::size_t nodeNum)
+{
+    timer.stop();
+    trace.clear(nodeNum);
+    markers.clear();
+    next = 0;
+    threadRank = 0;
+    waitTicks = 0;
+    paused = false;
+}
+
+void stepScheduler::addVisit(qint64 node)
+{
+    trace.addVisit(traversalTrace::index_type(node));
+}
+
+void stepScheduler::addThread(qint64 start, qint64 end, bool isLeft)
+{
+    trace.addThread(traversalTrace::index_type(start), traversalTrace::index_type(end), isLeft);
+}
+
+void stepScheduler::addTips(const QString& tips)
+{
+    trace.addMarker(traversalTrace::index_type(markers.size()));
+    markers.push_back(marker{tips, 0});
+}
+
+void stepScheduler::addPause(int ticks)
+{
+    trace.addMarker(traversalTrace::index_type(markers.size()));
+    markers.push_back(marker{QString(), ticks});
+}
+
+const traversalTrace& stepScheduler::getTrace() const
+{
+    return trace;
+}
+
+bool stepScheduler::isEmpty() const
+{
+    return trace.empty();
+}
+
+/**
+ * @brief stepScheduler::start 从头开始回放
+ */
+void stepScheduler::start()
+{
+    paused = false;
+    timer.start();
+    seek(0);
+}
+
+/**
+ * @brief stepScheduler::setPaused 暂停/继续
+ * @param _paused 是否暂停
+ */
+void stepScheduler::setPaused(bool _paused)
+{
+    if(!isActive())
+        return;
+    paused = _paused;
+    if(paused)
+        timer.stop();
+    else
+        timer.start();
+}
+
+/**
+ * @brief stepScheduler::cancel 停止播放，保留轨迹以便再次回放
+ */
+void stepScheduler::cancel()
+{
+    timer.stop();
+    paused = false;
+    waitTicks = 0;
+}
+
+/**
+ * @brief stepScheduler::setSpeed 调整播放速度，超过每秒60步时一拍播放多步
+ * @param stepsPerSecond 每秒播放的步数
+ */
+void stepScheduler::setSpeed(int stepsPerSecond)
+{
+    if(stepsPerSecond <= 0)
+        return;
+    int interval = qMax(16, 1000 / stepsPerSecond);
+    stepsPerTick = qMax(1, (stepsPerSecond * interval + 500) / 1000);
+    timer.setInterval(interval);
+}
+
+/**
+ * @brief stepScheduler::seek 跳转到某一位置，界面据轨迹直接恢复状态，无需重新执行遍历
+ * @param position 前position个事件已生效
+ */
+void stepScheduler::seek(std::size_t position)
+{
+    if(position > trace.size())
+        position = trace.size();
+    if(!isActive())
+        paused = true;      // 不在播放中时跳转，进入暂停状态
+    next = position;
+    threadRank = trace.threadNumBefore(position);
+    waitTicks = 0;
+    emit seeked(next);
+    emit progressChanged(next, trace.size());
+    finishIfEnded();
+}
+
+/**
+ * @brief stepScheduler::stepForward 前进一个可见的步骤
+ */
+void stepScheduler::stepForward()
+{
+    if(!isActive())
+        paused = true;
+    playMarkers();
+    playStep();
+    playMarkers();
+    if(next >= trace.size())
+        waitTicks = 0;      // 单步时末尾的停顿不再等待
+    emit progressChanged(next, trace.size());
+    finishIfEnded();
+}
+
+/**
+ * @brief stepScheduler::stepBackward 后退一个可见的步骤（回到该步骤生效之前）
+ */
+void stepScheduler::stepBackward()
+{
+    std::size_t position = next;
+    while(position > 0 && trace.getKind(position - 1) == traversalTrace::MARKER)
+        --position;
+    if(position > 0)
+        --position;
+    seek(position);
+}
+
+std::size_t stepScheduler::getPosition() const
+{
+    return next;
+}
+
+std::size_t stepScheduler::getLength() const
+{
+    return trace.size();
+}
+
+QString stepScheduler::getTips(std::size_t position) const
+{
+    // 从最近的标记向前找提示信息（停顿标记没有文字）
+    traversalTrace::index_type value;
+    if(!trace.lastMarkerBefore(position, value))
+        return QString();
+    for(int i = int(value); i >= 0; --i)
+        if(!markers[i].tips.isEmpty())
+            return markers[i].tips;
+    return QString();
+}
+
+// 是否处于播放中（包括暂停）
+bool stepScheduler::isActive() const
+{
+    return timer.isActive() || paused;
+}
+
+bool stepScheduler::isPaused() const
+{
+    return paused;
+}
+
+/**
+ * @brief stepScheduler::stepAt 将轨迹中的事件还原为步骤
+ */
+traversalStep stepScheduler::stepAt(std::size_t position) const
+{
+    traversalStep step;
+    traversalTrace::index_type value = trace.getValue(position);
+    switch(trace.getKind(position)){
+        case traversalTrace::VISIT:
+            step.kind = traversalStep::VISIT;
+            step.node = qint64(value);
+            break;
+        case traversalTrace::LEFT_THREAD:
+        case traversalTrace::RIGHT_THREAD:
+            step.kind = trace.getKind(position) == traversalTrace::LEFT_THREAD ? traversalStep::LEFT_THREAD : traversalStep::RIGHT_THREAD;
+            step.node = qint64(value);
+            step.target = qint64(trace.getThreadTarget(threadRank));
+            break;
+        case traversalTrace::MARKER:
+            step.kind = markers[int(value)].tips.isEmpty() ? traversalStep::PAUSE : traversalStep::TIPS;
+            step.tips = markers[int(value)].tips;
+            step.ticks = markers[int(value)].ticks;
+            break;
+    }
+    return step;
+}
+
+// 提示信息立即生效
+void stepScheduler::playMarkers()
+{
+    while(next < trace.size() && trace.getKind(next) == traversalTrace::MARKER && stepAt(next).kind == traversalStep::TIPS)
+        emit stepReady(stepAt(next++));
+}
+
+/**
+ * @brief stepScheduler::playStep 播放一个可见的步骤（或开始一次停顿）
+ * @return 是否还有剩余步骤
+ */
+bool stepScheduler::playStep()
+{
+    if(next >= trace.size())
+        return false;
+
+    traversalStep step = stepAt(next);
+    if(step.kind == traversalStep::LEFT_THREAD || step.kind == traversalStep::RIGHT_THREAD)
+        ++threadRank;
+    ++next;
+    if(step.kind == traversalStep::PAUSE)
+        waitTicks = step.ticks - 1;
+    else
+        emit stepReady(step);
+    return true;
+}
+
+/**
+ * @brief stepScheduler::handleTick 每拍播放若干步，TIPS与停顿不占用可见的访问拍
+ */
+void stepScheduler::handleTick()
+{
+    for(int i = 0; i < stepsPerTick; ++i){
+        if(waitTicks > 0){
+            --waitTicks;
+            break;
+        }
+        playMarkers();
+        if(!playStep())
+            break;
+        // 末尾的提示信息一并播放
+        playMarkers();
+    }
+    emit progressChanged(next, trace.size());
+    finishIfEnded();
+}
+
+/**
+ * @brief stepScheduler::finishIfEnded 播放（或单步、跳转）到末尾且没有剩余停顿时结束播放
+ */
+void stepScheduler::finishIfEnded()
+{
+    if(next >= trace.size() && waitTicks == 0 && isActive()){
+        timer.stop();
+        paused = false;
+        emit finished();
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef STEPSCHEDULER_H
+#define STEPSCHEDULER_H
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <QString>
+#include "traversaltrace.h"
+
+// 遍历动画中的一步
+struct traversalStep
+{
+    enum KIND { VISIT, LEFT_THREAD, RIGHT_THREAD, TIPS, PAUSE };
+
+    KIND kind;
+    qint64 node = -1;       // 访问/线索的起点（结点编号）
+    qint64 target = -1;     // 线索的终点
+    QString tips;           // 提示信息
+    int ticks = 0;          // 停顿的拍数
+};
+
+// 遍历动画的调度器
+// 遍历算法全速执行一次、把步骤记录为紧凑的轨迹（traversalTrace），之后可反复回放：
+// 由单个定时器每拍取出若干步播放，可调速、暂停/继续、单步前进/后退与任意跳转
+class stepScheduler: public QObject
+{
+    Q_OBJECT
+
+private:
+    // 标记事件的内容：提示信息或停顿
+    struct marker
+    {
+        QString tips;
+        int ticks;
+    };
+
+    QTimer timer;
+    traversalTrace trace;
+    QVector<marker> markers;
+    std::size_t next = 0;           // 下一步的位置
+    std::size_t threadRank = 0;     // 已播放的线索数
+    int waitTicks = 0;              // 剩余停顿拍数
+    int stepsPerTick = 1;           // 每拍播放的步数（高速时一拍多步）
+    bool paused = false;
+
+    void handleTick();
+    bool playStep();
+    void playMarkers();
+    void finishIfEnded();
+    traversalStep stepAt(std::size_t position) const;
+
+public:
+    explicit stepScheduler(int interval = 500, QObject* parent = nullptr);
+
+    // 记录步骤（nodeNum为结点数，编号须小于它）
+    void clear(std::size_t nodeNum = 0);
+    void addVisit(qint64 node);
+    void addThread(qint64 start, qint64 end, bool isLeft);
+    void addTips(const QString& tips);
+    void addPause(int ticks);
+
+    const traversalTrace& getTrace() const;
+    bool isEmpty() const;
+
+    // 播放控制
+    void start();
+    void setPaused(bool _paused);
+    void cancel();
+    void setSpeed(int stepsPerSecond);
+
+    // 跳转（不在播放中时进入暂停状态）
+    void seek(std::size_t position);
+    void stepForward();
+    void stepBackward();
+
+    std::size_t getPosition() const;
+    std::size_t getLength() const;
+    QString getTips(std::size_t position) const;    // position之前最近的提示信息
+
+    bool isActive() const;
+    bool isPaused() const;
+
+signals:
+    void stepReady(const traversalStep& step);
+    void seeked(std::size_t position);                          // 跳转后，界面按轨迹恢复该位置的状态
+    void progressChanged(std::size_t position, std::size_t length);
+    void finished();
+};
+
+#endif // STEPSCHEDULER_H